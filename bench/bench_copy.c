@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+/*
+ * Benchmark of large copies by Buffer_Write and Buffer_WriteNonTemporal.
+ *
+ * Every round copies a large payload and then walks a small hot working set, the time of
+ * the walk shows how much of the working set the copy evicted from the caches.
+ */
+
+// cc -O2 -Iinclude bench/bench_copy.c src/*.c -lpthread -o bench_copy
+// ./bench_copy [payload MB] [working set KB] [rounds]
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "buffer.h"
+#include "buffer_cpu.h"
+
+static double Bench_Now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+static uint64_t Bench_Walk(const uint8_t * hot, size_t size)
+{
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < size; i += 64) {
+        sum += hot[i];
+    }
+    return sum;
+}
+
+static void Bench_Run(const char * name, bool nonTemporal, const uint8_t * payload, size_t payloadSize,
+                      Buffer * buff, const uint8_t * hot, size_t hotSize, unsigned rounds)
+{
+    double copyTime = 0;
+    double walkTime = 0;
+    uint64_t sum = 0;
+
+    for (unsigned i = 0; i < rounds; i++) {
+        double start;
+
+        sum += Bench_Walk(hot, hotSize);
+
+        Buffer_Clear(buff);
+        start = Bench_Now();
+        if (nonTemporal) {
+            Buffer_WriteNonTemporal(buff, payload, payloadSize);
+        } else {
+            Buffer_Write(buff, payload, payloadSize);
+        }
+        copyTime += Bench_Now() - start;
+
+        start = Bench_Now();
+        sum += Bench_Walk(hot, hotSize);
+        walkTime += Bench_Now() - start;
+    }
+
+    printf("%-14s copy %8.2f GB/s   hot walk after copy %8.2f us   (%llu)\n", name,
+           (double)payloadSize * rounds / copyTime / 1e9, walkTime / rounds * 1e6, (unsigned long long)sum);
+}
+
+int main(int argc, char ** argv)
+{
+    size_t payloadSize = (argc > 1 ? (size_t)atol(argv[1]) : 64) * 1024 * 1024;
+    size_t hotSize = (argc > 2 ? (size_t)atol(argv[2]) : 512) * 1024;
+    unsigned rounds = argc > 3 ? (unsigned)atoi(argv[3]) : 20;
+    static const char * levels[] = {"scalar", "ssse3", "avx2", "avx512"};
+    uint8_t * payload = malloc(payloadSize);
+    uint8_t * hot = malloc(hotSize);
+    Buffer buff = Buffer_AllocData(payloadSize);
+
+    if (payload == NULL || hot == NULL || buff.data == NULL) {
+        fprintf(stderr, "allocation failed\n");
+        return 1;
+    }
+
+    memset(payload, 0x5a, payloadSize);
+    memset(hot, 0xa5, hotSize);
+    memset(buff.data, 0, buff.size);
+
+    printf("payload %zu MB, working set %zu KB, %u rounds, kernels %s\n", payloadSize >> 20, hotSize >> 10, rounds,
+           levels[BufferCpu_GetLevel()]);
+
+    Bench_Run("Buffer_Write", false, payload, payloadSize, &buff, hot, hotSize, rounds);
+    Bench_Run("NonTemporal", true, payload, payloadSize, &buff, hot, hotSize, rounds);
+
+    Buffer_FreeData(&buff);
+    free(hot);
+    free(payload);
+    return 0;
+}
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+/*
+ * Coroutine decoder fed by an epoll loop from a local socket.
+ *
+ * The sender thread writes messages of u8 type, varint length and payload in fragments
+ * of a few bytes, the decoder is written as if all data were already there.
+ */
+
+// cc -c -Iinclude src/*.c
+// c++ -std=c++20 -Iinclude examples/coro_epoll.cpp *.o -lpthread
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "buffer_coro.hpp"
+
+using buffer::BufferReader;
+using buffer::EndOfInput;
+using buffer::ReadTask;
+
+struct Message {
+    uint8_t type;
+    std::string payload;
+};
+
+static ReadTask<Message> ReadMessage(BufferReader & reader)
+{
+    Message message;
+
+    message.type = co_await reader.u8();
+    uint64_t length = co_await reader.varU64();
+    ConstBuffer payload = co_await reader.bytes(length);
+    message.payload.assign(payload.sdata + payload.read, payload.size - payload.read);
+    co_return message;
+}
+
+static ReadTask<> Session(BufferReader & reader, unsigned & count)
+{
+    try {
+        for (;;) {
+            Message message = co_await ReadMessage(reader);
+            std::printf("type %u: %s\n", message.type, message.payload.c_str());
+            count++;
+        }
+    } catch (const EndOfInput &) {
+        if (reader.available() > 0) {
+            std::printf("truncated message\n");
+        }
+    }
+}
+
+static void Send(int fd)
+{
+    BUFFER_INLINE(out, 1024);
+
+    for (uint8_t i = 0; i < 10; i++) {
+        std::string text = "message " + std::to_string(i) + std::string(i * 20, '.');
+
+        Buffer_WriteU8(&out, i);
+        Buffer_WriteVarU64(&out, text.size());
+        Buffer_Write(&out, text.data(), text.size());
+    }
+
+    /* fragments cut across fields */
+    for (size_t sent = 0; sent < out.written;) {
+        size_t size = out.written - sent < 7 ? out.written - sent : 7;
+        ssize_t result = write(fd, out.data + sent, size);
+
+        if (result < 0) {
+            break;
+        }
+        sent += (size_t)result;
+        usleep(100);
+    }
+    close(fd);
+}
+
+int main()
+{
+    int fds[2];
+    unsigned count = 0;
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        std::perror("socketpair");
+        return 1;
+    }
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+
+    int epoll = epoll_create1(0);
+    struct epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = fds[0];
+    epoll_ctl(epoll, EPOLL_CTL_ADD, fds[0], &event);
+
+    std::thread sender(Send, fds[1]);
+
+    BufferReader reader(64);
+    ReadTask<> session = Session(reader, count);
+
+    while (!session.done()) {
+        struct epoll_event ready;
+
+        if (epoll_wait(epoll, &ready, 1, -1) <= 0) {
+            continue;
+        }
+
+        Buffer * input = reader.writable(256);
+        if (input == nullptr) {
+            std::printf("out of memory\n");
+            reader.close();
+            break;
+        }
+
+        ssize_t result = read(fds[0], input->data + input->written, input->size - input->written);
+
+        if (result > 0) {
+            input->written += (size_t)result;
+            reader.notify();
+        } else if (result == 0) {
+            reader.close();
+        }
+    }
+
+    sender.join();
+    close(epoll);
+    close(fds[0]);
+
+    std::printf("%u messages\n", count);
+    return count == 10 ? 0 : 1;
+}
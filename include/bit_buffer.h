@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#ifndef BIT_BUFFER_H
+#define BIT_BUFFER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "buffer.h"
+
+enum _bitOrder {
+    BIT_ORDER_MSB_FIRST,
+    BIT_ORDER_LSB_FIRST,
+};
+typedef enum _bitOrder BitOrder;
+
+struct _bitBuffer {
+    Buffer * buff;
+    uint64_t acc;
+    uint8_t bits;
+    BitOrder order;
+};
+typedef struct _bitBuffer BitBuffer;
+
+struct _constBitBuffer {
+    ConstBuffer * buff;
+    uint64_t acc;
+    uint8_t bits;
+    BitOrder order;
+};
+typedef struct _constBitBuffer ConstBitBuffer;
+
+/**
+ * @brief Start writing bits to the buffer
+ *
+ * Bits are collected in an accumulator and written to the buffer by whole 32 bit words,
+ * BitBuffer_Flush must be called to write the rest.
+ * @param buff
+ * @param order
+ * @return BitBuffer
+ */
+BitBuffer BitBuffer_Init(Buffer * buff, BitOrder order);
+
+/**
+ * @brief Write the lowest count bits of the value
+ *
+ * before calling, it is necessary to check the number of available bytes in the buffer
+ * @param bits
+ * @param val
+ * @param count number of bits, 0 - 64
+ */
+void BitBuffer_Write(BitBuffer * bits, uint64_t val, uint8_t count);
+
+/**
+ * @brief Write remaining bits to the buffer
+ *
+ * Last byte is padded by zero bits.
+ * @param bits
+ */
+void BitBuffer_Flush(BitBuffer * bits);
+
+/**
+ * @brief Start reading bits from the buffer
+ *
+ * The buffer is read ahead by whole words, use BitBuffer_ReadAlign to return unused bytes.
+ * @param buff
+ * @param order
+ * @return ConstBitBuffer
+ */
+ConstBitBuffer ConstBitBuffer_Init(ConstBuffer * buff, BitOrder order);
+
+/**
+ * @brief Read count bits
+ *
+ * @param bits
+ * @param count number of bits, 0 - 64
+ * @return read value or 0 when there is not enough data
+ */
+uint64_t BitBuffer_Read(ConstBitBuffer * bits, uint8_t count);
+
+/**
+ * BitBuffer_ReadAvailable
+ * @param bits
+ * @return the number of bits which can be read
+ */
+size_t BitBuffer_ReadAvailable(ConstBitBuffer * bits);
+
+/**
+ * @brief Skip to the next byte boundary
+ *
+ * Whole bytes read ahead to the accumulator are returned to the buffer, so byte oriented
+ * reading can continue right after the bit field.
+ * @param bits
+ */
+void BitBuffer_ReadAlign(ConstBitBuffer * bits);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BIT_BUFFER_H */
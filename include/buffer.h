@@ -12,6 +12,21 @@ extern "C" {
 #include <stddef.h>
 #include <stdbool.h>
 
+/* how Buffer data were allocated, zero value is data allocated by malloc */
+enum _bufferAlloc {
+    BUFFER_ALLOC_HEAP,
+    BUFFER_ALLOC_ALIGNED,
+    BUFFER_ALLOC_MAPPED,
+    BUFFER_ALLOC_STATIC,
+    BUFFER_ALLOC_NONE,
+};
+typedef enum _bufferAlloc BufferAlloc;
+
+/*
+ * Buffers built by hand own data allocated by malloc unless they set alloc. Set
+ * BUFFER_ALLOC_STATIC for storage which may be left for the heap when the buffer grows,
+ * or BUFFER_ALLOC_NONE for data which must be neither freed nor reallocated.
+ */
 struct _buffer {
     union {
         uint8_t * data;
@@ -19,6 +34,7 @@ struct _buffer {
     };
     size_t size;
     size_t written;
+    BufferAlloc alloc;
 };
 typedef struct _buffer Buffer;
 
@@ -32,6 +48,33 @@ struct _constBuffer {
 };
 typedef struct _constBuffer ConstBuffer;
 
+struct _bufferAllocOptions {
+    size_t alignment;
+    bool hugePages;
+    bool prefault;
+};
+typedef struct _bufferAllocOptions BufferAllocOptions;
+
+/**
+ * @brief Declare Buffer with inline storage of compile-time capacity
+ *
+ * Storage is placed next to the buffer on the stack. The macro is a declaration with
+ * initializer, so it can not declare struct members, embed BUFFER_SMALL in structs and
+ * initialize it by BUFFER_SMALL_INIT instead.
+ */
+#define BUFFER_INLINE(name, capacity) \
+    uint8_t name##_storage[capacity]; \
+    Buffer name = { .data = name##_storage, .size = (capacity), .written = 0, .alloc = BUFFER_ALLOC_STATIC }
+
+/**
+ * @brief Type of buffer with inline storage which moves to the heap when it outgrows it
+ *
+ * Initialize it by BUFFER_SMALL_INIT, grow it by Buffer_Reserve and release by Buffer_FreeData.
+ */
+#define BUFFER_SMALL(capacity) struct { Buffer buff; uint8_t storage[capacity]; }
+
+#define BUFFER_SMALL_INIT(small) Buffer_InitStatic(&(small)->buff, (small)->storage, sizeof((small)->storage))
+
 /**
  * @brief Allocate Buffer internal data
  *
@@ -40,13 +83,52 @@ typedef struct _constBuffer ConstBuffer;
  */
 Buffer Buffer_AllocData(size_t size);
 
+/**
+ * @brief Allocate Buffer internal data with options
+ *
+ * alignment - power of two alignment of data, 0 for default
+ * hugePages - map data by huge pages (MAP_HUGETLB) or advise the kernel to back them by
+ *             transparent huge pages (MADV_HUGEPAGE), size is rounded up to whole pages
+ *             and mapped data are huge page aligned
+ * prefault  - touch all pages, so the first pass through the buffer does not page fault
+ *
+ * Options which are not supported on the platform are ignored.
+ * @param size
+ * @param options
+ * @return Buffer
+ */
+Buffer Buffer_AllocDataEx(size_t size, const BufferAllocOptions * options);
+
 /**
  * @brief Free Buffer internal data
  *
+ * Data are released by the same way they were allocated, data which are not owned by
+ * the buffer (BUFFER_ALLOC_NONE, BUFFER_ALLOC_STATIC) are left alone.
  * @param buff
  */
 void Buffer_FreeData(Buffer * buff);
 
+/**
+ * @brief Initialize buffer over storage which is not owned by the buffer
+ *
+ * Buffer_FreeData does not free the storage, Buffer_Reserve moves data to the heap.
+ * @param buff
+ * @param data
+ * @param size
+ */
+void Buffer_InitStatic(Buffer * buff, void * data, size_t size);
+
+/**
+ * @brief Make sure the buffer has at least size bytes available for writing
+ *
+ * Data of static buffers are moved to the heap, heap buffers are reallocated. Only buffers
+ * allocated by Buffer_AllocData or initialized by Buffer_InitStatic can grow.
+ * @param buff
+ * @param size
+ * @return false when the buffer can not grow
+ */
+bool Buffer_Reserve(Buffer * buff, size_t size);
+
 /**
  * Buffer_WriteAvailable
  * @param buff
@@ -118,6 +200,16 @@ void Buffer_WriteS16(Buffer * buff, int16_t val);
  */
 void Buffer_WriteS8(Buffer * buffer, int8_t val);
 
+/**
+ * @brief Write uint64 to the buffer as varint
+ *
+ * Value is written by 7 bits from the least significant ones, highest bit of the byte
+ * is set when more bytes follow (LEB128). Takes 1 - 10 bytes.
+ * @param buff
+ * @param val
+ */
+void Buffer_WriteVarU64(Buffer * buff, uint64_t val);
+
 /**
  * @brief Write string to the buffer
  *
@@ -127,6 +219,37 @@ void Buffer_WriteS8(Buffer * buffer, int8_t val);
  */
 void Buffer_WriteStr(Buffer * buff, const char * data, size_t dataSize);
 
+/**
+ * @brief Write string with uint8 length prefix to the buffer
+ *
+ * Nothing is written when the string is longer than 255 bytes or does not fit.
+ * @param buff
+ * @param data
+ * @param dataSize
+ */
+void Buffer_WriteStr8(Buffer * buff, const char * data, size_t dataSize);
+
+/**
+ * @brief Write string with uint16 length prefix to the buffer
+ *
+ * Nothing is written when the string is longer than 65535 bytes or does not fit.
+ * @param buff
+ * @param data
+ * @param dataSize
+ */
+void Buffer_WriteStr16(Buffer * buff, const char * data, size_t dataSize);
+
+/**
+ * @brief Write string with varint length prefix to the buffer
+ *
+ * Nothing is written when the string does not fit.
+ * @param buff
+ * @param data
+ * @param dataSize
+ * @see Buffer_WriteVarU64
+ */
+void Buffer_WriteStrVar(Buffer * buff, const char * data, size_t dataSize);
+
 /**
  * Write multiple data to the buffer
  *
@@ -136,6 +259,19 @@ void Buffer_WriteStr(Buffer * buff, const char * data, size_t dataSize);
  */
 void Buffer_Write(Buffer * buff, const void * data, size_t dataSize);
 
+/**
+ * @brief Write large data to the buffer without polluting CPU caches
+ *
+ * Data of at least BUFFER_NON_TEMPORAL_MIN bytes are copied by non-temporal stores which
+ * bypass the caches, use it for data which will not be read again soon. Smaller data,
+ * or on CPUs without streaming stores and on other than x86 targets, are copied as by
+ * Buffer_Write.
+ * @param buff
+ * @param data
+ * @param dataSize
+ */
+void Buffer_WriteNonTemporal(Buffer * buff, const void * data, size_t dataSize);
+
 /**
  * @brief Clear written data in the buffer
  *
@@ -161,6 +297,56 @@ void Buffer_MoveBy(Buffer * buff, size_t offset);
  */
 size_t Buffer_ReadAvailable(ConstBuffer * buff);
 
+/**
+ * @brief Get current read position
+ *
+ * @param buff
+ * @return mark for ConstBuffer_Rewind
+ */
+size_t ConstBuffer_Mark(ConstBuffer * buff);
+
+/**
+ * @brief Return read position back to the mark
+ *
+ * Used when a message turns out to be incomplete, it can be parsed again from the mark
+ * when more data arrive.
+ * @param buff
+ * @param mark
+ */
+void ConstBuffer_Rewind(ConstBuffer * buff, size_t mark);
+
+/**
+ * @brief Peek uint64 from the buffer without moving read position
+ *
+ * @param buff
+ * @return uint64_t or 0 when there is not enough data
+ */
+uint64_t Buffer_PeekU64(ConstBuffer * buff);
+
+/**
+ * @brief Peek uint32 from the buffer without moving read position
+ *
+ * @param buff
+ * @return uint32_t or 0 when there is not enough data
+ */
+uint32_t Buffer_PeekU32(ConstBuffer * buff);
+
+/**
+ * @brief Peek uint16 from the buffer without moving read position
+ *
+ * @param buff
+ * @return uint16_t or 0 when there is not enough data
+ */
+uint16_t Buffer_PeekU16(ConstBuffer * buff);
+
+/**
+ * @brief Peek uint8 from the buffer without moving read position
+ *
+ * @param buff
+ * @return uint8_t or 0 when there is not enough data
+ */
+uint8_t Buffer_PeekU8(ConstBuffer * buff);
+
 /**
  * @brief Read uint64 from the buffer
  *
@@ -225,6 +411,45 @@ int16_t Buffer_ReadS16(ConstBuffer * buff);
  */
 int8_t Buffer_ReadS8(ConstBuffer * buff);
 
+/**
+ * @brief Read varint from the buffer
+ *
+ * @param buff
+ * @return read value or 0 when the varint is not complete or it overflows 64 bits
+ */
+uint64_t Buffer_ReadVarU64(ConstBuffer * buff);
+
+/**
+ * @brief Read string with uint8 length prefix from the buffer
+ *
+ * Data are not copied, str points to the string inside the buffer. The string is not
+ * zero terminated.
+ * @param buff
+ * @param str
+ * @return false when the string is not complete, read position is not changed then
+ */
+bool Buffer_ReadStr8(ConstBuffer * buff, ConstBuffer * str);
+
+/**
+ * @brief Read string with uint16 length prefix from the buffer
+ *
+ * @param buff
+ * @param str
+ * @return false when the string is not complete
+ * @see Buffer_ReadStr8
+ */
+bool Buffer_ReadStr16(ConstBuffer * buff, ConstBuffer * str);
+
+/**
+ * @brief Read string with varint length prefix from the buffer
+ *
+ * @param buff
+ * @param str
+ * @return false when the string is not complete
+ * @see Buffer_ReadStr8
+ */
+bool Buffer_ReadStrVar(ConstBuffer * buff, ConstBuffer * str);
+
 /**
  * Buffer_Read
  * read remaining data from source buffer to destination pointer
@@ -235,6 +460,17 @@ int8_t Buffer_ReadS8(ConstBuffer * buff);
  */
 bool Buffer_Read(ConstBuffer * source, void * destination, size_t destinationSize);
 
+/**
+ * @brief Read large data from the buffer without polluting CPU caches
+ *
+ * @see Buffer_WriteNonTemporal
+ * @param source
+ * @param destination
+ * @param destinationSize
+ * @return false when there is not enough data
+ */
+bool Buffer_ReadNonTemporal(ConstBuffer * source, void * destination, size_t destinationSize);
+
 /**
  * @brief Write formated data to the buffer
  *
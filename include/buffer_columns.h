@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#ifndef BUFFER_COLUMNS_H
+#define BUFFER_COLUMNS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "buffer.h"
+
+/*
+ * Records have fixed size and consist of big endian unsigned integers at fixed offsets,
+ * bytes not covered by any column are skipped. Every field of the record has its own
+ * array (column) of host endian values.
+ */
+
+struct _bufferColumn {
+    size_t offset;
+    size_t size;
+    void * data;
+};
+typedef struct _bufferColumn BufferColumn;
+
+/**
+ * @brief Write records from the columns
+ *
+ * Bytes not covered by any column are zero. Nothing is written when the records do not fit.
+ * @param buff
+ * @param recordSize
+ * @param columns offset and size (1, 2, 4 or 8) of the field in the record and array of count values
+ * @param columnCount
+ * @param count number of records
+ * @return false when the layout is not valid or the records do not fit
+ */
+bool Buffer_WriteColumns(Buffer * buff, size_t recordSize, const BufferColumn * columns, size_t columnCount,
+                         size_t count);
+
+/**
+ * @brief Read records to the columns
+ *
+ * Records are decoded in blocks which stay in cache, field by field, so every column
+ * is written sequentially.
+ * @param buff
+ * @param recordSize
+ * @param columns offset and size (1, 2, 4 or 8) of the field in the record and array for count values
+ * @param columnCount
+ * @param count number of records
+ * @return false when the layout is not valid or there are not enough data, nothing is read then
+ */
+bool Buffer_ReadColumns(ConstBuffer * buff, size_t recordSize, const BufferColumn * columns, size_t columnCount,
+                        size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUFFER_COLUMNS_H */
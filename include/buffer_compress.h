@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#ifndef BUFFER_COMPRESS_H
+#define BUFFER_COMPRESS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "buffer.h"
+
+#ifndef BUFFER_COMPRESS_HASH_LOG
+#define BUFFER_COMPRESS_HASH_LOG 12
+#endif
+
+/**
+ * @brief Match finder table of Buffer_Compress
+ *
+ * It takes 4 << BUFFER_COMPRESS_HASH_LOG bytes, keep it off small task stacks.
+ */
+struct _bufferCompressTable {
+    uint32_t positions[1 << BUFFER_COMPRESS_HASH_LOG];
+};
+typedef struct _bufferCompressTable BufferCompressTable;
+
+/**
+ * @brief Flush hook of the compressed writer
+ *
+ * @param ctx
+ * @param frame complete compressed frame, it is valid only during the call
+ * @return false to report failure from CompressedWriter_Flush
+ */
+typedef bool (*BufferFlushHook)(void * ctx, ConstBuffer * frame);
+
+/**
+ * @brief Refill hook of the compressed reader
+ *
+ * Appends more compressed data to the free space of the buffer.
+ * @param ctx
+ * @param buff
+ * @return false when there are no more data
+ */
+typedef bool (*BufferRefillHook)(void * ctx, Buffer * buff);
+
+struct _compressedWriter {
+    Buffer input;
+    Buffer output;
+    BufferCompressTable * table;
+    BufferFlushHook flush;
+    void * ctx;
+};
+typedef struct _compressedWriter CompressedWriter;
+
+struct _compressedReader {
+    Buffer input;
+    Buffer output;
+    ConstBuffer block;
+    BufferRefillHook refill;
+    void * ctx;
+};
+typedef struct _compressedReader CompressedReader;
+
+/**
+ * Buffer_CompressBound
+ * @param size
+ * @return the maximal compressed size of size bytes
+ */
+size_t Buffer_CompressBound(size_t size);
+
+/**
+ * @brief Compress unread data of the source to the destination buffer
+ *
+ * Output is LZ4 block format. Nothing is written and nothing is read when the compressed
+ * data do not fit, reserve Buffer_CompressBound bytes to be sure.
+ * @param destination
+ * @param source
+ * @param table scratch table, its content is not kept between calls
+ * @return false when the compressed data do not fit
+ */
+bool Buffer_Compress(Buffer * destination, ConstBuffer * source, BufferCompressTable * table);
+
+/**
+ * @brief Decompress block of compressedSize bytes from the source to the destination buffer
+ *
+ * On failure read and written positions are not changed.
+ * @param destination
+ * @param source
+ * @param compressedSize
+ * @return false when the block is not valid or does not fit
+ */
+bool Buffer_Decompress(Buffer * destination, ConstBuffer * source, size_t compressedSize);
+
+/**
+ * @brief Initialize writer of compressed frames
+ *
+ * Data are written to the buffer returned by CompressedWriter_GetBuffer. When
+ * CompressedWriter_Flush is called, the data are compressed to a frame and passed to the flush hook.
+ * Frame is U32 compressed size (highest bit set when stored uncompressed), U32 size of
+ * the data and the block.
+ * @param writer
+ * @param blockSize maximal size of data in a frame
+ * @param flush
+ * @param ctx
+ * @return false when allocation fails
+ */
+bool CompressedWriter_Init(CompressedWriter * writer, size_t blockSize, BufferFlushHook flush, void * ctx);
+
+/**
+ * @brief Free the writer buffers, unflushed data are lost
+ *
+ * @param writer
+ */
+void CompressedWriter_Deinit(CompressedWriter * writer);
+
+/**
+ * @brief Get the buffer to write data to
+ *
+ * Check the available space before writing and call CompressedWriter_Flush when it is not enough.
+ * @param writer
+ * @return Buffer
+ */
+Buffer * CompressedWriter_GetBuffer(CompressedWriter * writer);
+
+/**
+ * @brief Compress written data to a frame and pass it to the flush hook
+ *
+ * Data are kept when the flush hook fails, so the flush can be retried.
+ * @param writer
+ * @return result of the flush hook, true when there are no data
+ */
+bool CompressedWriter_Flush(CompressedWriter * writer);
+
+/**
+ * @brief Initialize reader of compressed frames
+ *
+ * @param reader
+ * @param blockSize must be at least block size of the writer
+ * @param refill
+ * @param ctx
+ * @return false when allocation fails
+ */
+bool CompressedReader_Init(CompressedReader * reader, size_t blockSize, BufferRefillHook refill, void * ctx);
+
+/**
+ * @brief Free the reader buffers
+ *
+ * @param reader
+ */
+void CompressedReader_Deinit(CompressedReader * reader);
+
+/**
+ * @brief Decompress next frame
+ *
+ * @param reader
+ * @return data of the frame valid until the next call or NULL at the end of data or on error
+ */
+ConstBuffer * CompressedReader_Next(CompressedReader * reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUFFER_COMPRESS_H */
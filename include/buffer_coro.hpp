@@ -0,0 +1,347 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#ifndef BUFFER_CORO_HPP
+#define BUFFER_CORO_HPP
+
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+
+#include <coroutine>
+#include <cstdint>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "buffer.h"
+
+/*
+ * Decoders are coroutines returning ReadTask, which await values from BufferReader.
+ * When the reader does not have enough data, the decoder is suspended and it is resumed
+ * by the event loop when more data arrive, so partial input needs no state machine.
+ */
+
+namespace buffer {
+
+/**
+ * @brief Thrown from co_await when the reader is closed before enough data arrive
+ */
+class EndOfInput : public std::runtime_error {
+public:
+    EndOfInput() : std::runtime_error("end of input") {}
+};
+
+namespace detail {
+
+struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept
+    {
+        std::coroutine_handle<> continuation = handle.promise().continuation;
+        return continuation ? continuation : std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr exception;
+
+    /* tasks start right away and run until they miss data */
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+    void rethrow() const
+    {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+};
+
+template <typename T>
+struct Promise : PromiseBase {
+    std::optional<T> value;
+
+    void return_value(T val) { value.emplace(std::move(val)); }
+
+    T result()
+    {
+        rethrow();
+        return std::move(*value);
+    }
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+    void return_void() const noexcept {}
+    void result() const { rethrow(); }
+};
+
+} // namespace detail
+
+/**
+ * @brief Decoder coroutine
+ *
+ * Task can be awaited by another task, its result or exception is passed to the awaiting one.
+ */
+template <typename T = void>
+class ReadTask {
+public:
+    struct promise_type : detail::Promise<T> {
+        ReadTask get_return_object() { return ReadTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+    };
+
+    ReadTask(ReadTask && other) noexcept : handle(std::exchange(other.handle, {})) {}
+
+    ReadTask & operator=(ReadTask && other) noexcept
+    {
+        if (this != &other) {
+            if (handle) {
+                handle.destroy();
+            }
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+
+    ReadTask(const ReadTask &) = delete;
+    ReadTask & operator=(const ReadTask &) = delete;
+
+    /**
+     * @brief Destroy the coroutine
+     *
+     * Close the reader first when the task still waits for data.
+     */
+    ~ReadTask()
+    {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    bool done() const { return handle.done(); }
+
+    /**
+     * @brief Get value of the finished task
+     *
+     * @return value returned by the coroutine, exception thrown by it is rethrown
+     */
+    T result() { return handle.promise().result(); }
+
+    bool await_ready() const noexcept { return handle.done(); }
+    void await_suspend(std::coroutine_handle<> awaiting) noexcept { handle.promise().continuation = awaiting; }
+    T await_resume() { return handle.promise().result(); }
+
+private:
+    explicit ReadTask(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+/**
+ * @brief Input of decoder coroutines
+ *
+ * Event loop appends received data by feed, or writes them to the buffer returned by
+ * writable and calls notify. A single task chain may wait on the reader at a time,
+ * it is resumed from feed, notify or close.
+ */
+class BufferReader {
+public:
+    explicit BufferReader(size_t capacity) : input(Buffer_AllocData(capacity)) {}
+
+    ~BufferReader() { Buffer_FreeData(&input); }
+
+    BufferReader(const BufferReader &) = delete;
+    BufferReader & operator=(const BufferReader &) = delete;
+
+    /**
+     * @brief Append data and resume the waiting decoder when it has enough of them
+     *
+     * @param data
+     * @param size
+     * @return false when the input can not grow
+     */
+    bool feed(const void * data, size_t size)
+    {
+        Buffer * buff = writable(size);
+
+        if (buff == nullptr) {
+            return false;
+        }
+        Buffer_Write(buff, data, size);
+        notify();
+        return true;
+    }
+
+    /**
+     * @brief Get input buffer with at least size bytes available for writing
+     *
+     * Consumed data are discarded first, so views returned by bytes are valid only until
+     * the next call. Call notify after increasing written bytes.
+     * @param size
+     * @return Buffer or nullptr when the input can not grow
+     */
+    Buffer * writable(size_t size)
+    {
+        if (Buffer_WriteAvailable(&input) < size && read > 0) {
+            Buffer_MoveBy(&input, read);
+            read = 0;
+        }
+        if (!Buffer_Reserve(&input, size)) {
+            return nullptr;
+        }
+        return &input;
+    }
+
+    /**
+     * @brief Resume the waiting decoder when there are enough data
+     */
+    void notify()
+    {
+        if (waiter && (available() >= needed || closed)) {
+            std::exchange(waiter, {}).resume();
+        }
+    }
+
+    /**
+     * @brief Mark end of input
+     *
+     * The waiting decoder is resumed and EndOfInput is thrown to it, later reads which
+     * miss data throw right away.
+     */
+    void close()
+    {
+        closed = true;
+        notify();
+    }
+
+    /**
+     * available
+     * @return the number of received bytes which were not consumed yet
+     */
+    size_t available() const { return input.written - read; }
+
+    class NeedAwaiter {
+    public:
+        NeedAwaiter(BufferReader & reader, size_t size) : reader(reader), size(size) {}
+
+        bool await_ready() const noexcept { return reader.available() >= size || reader.closed; }
+
+        void await_suspend(std::coroutine_handle<> handle) noexcept
+        {
+            reader.waiter = handle;
+            reader.needed = size;
+        }
+
+        void await_resume() const
+        {
+            if (reader.available() < size) {
+                throw EndOfInput();
+            }
+        }
+
+    protected:
+        BufferReader & reader;
+        size_t size;
+    };
+
+    template <typename T, T (*Read)(ConstBuffer *)>
+    class ValueAwaiter : public NeedAwaiter {
+    public:
+        explicit ValueAwaiter(BufferReader & reader) : NeedAwaiter(reader, sizeof(T)) {}
+
+        T await_resume()
+        {
+            NeedAwaiter::await_resume();
+            ConstBuffer view = reader.view();
+            reader.read += sizeof(T);
+            return Read(&view);
+        }
+    };
+
+    class BytesAwaiter : public NeedAwaiter {
+    public:
+        BytesAwaiter(BufferReader & reader, size_t size) : NeedAwaiter(reader, size) {}
+
+        ConstBuffer await_resume()
+        {
+            NeedAwaiter::await_resume();
+            ConstBuffer view = reader.view();
+            view.size = view.read + size;
+            reader.read += size;
+            return view;
+        }
+    };
+
+    /**
+     * @brief Wait until at least size bytes are available without consuming them
+     */
+    NeedAwaiter need(size_t size) { return NeedAwaiter(*this, size); }
+
+    ValueAwaiter<uint8_t, Buffer_ReadU8> u8() { return ValueAwaiter<uint8_t, Buffer_ReadU8>(*this); }
+    ValueAwaiter<uint16_t, Buffer_ReadU16> u16() { return ValueAwaiter<uint16_t, Buffer_ReadU16>(*this); }
+    ValueAwaiter<uint32_t, Buffer_ReadU32> u32() { return ValueAwaiter<uint32_t, Buffer_ReadU32>(*this); }
+    ValueAwaiter<uint64_t, Buffer_ReadU64> u64() { return ValueAwaiter<uint64_t, Buffer_ReadU64>(*this); }
+    ValueAwaiter<int8_t, Buffer_ReadS8> s8() { return ValueAwaiter<int8_t, Buffer_ReadS8>(*this); }
+    ValueAwaiter<int16_t, Buffer_ReadS16> s16() { return ValueAwaiter<int16_t, Buffer_ReadS16>(*this); }
+    ValueAwaiter<int32_t, Buffer_ReadS32> s32() { return ValueAwaiter<int32_t, Buffer_ReadS32>(*this); }
+    ValueAwaiter<int64_t, Buffer_ReadS64> s64() { return ValueAwaiter<int64_t, Buffer_ReadS64>(*this); }
+
+    /**
+     * @brief Wait for size bytes and consume them
+     *
+     * Result is a view of the input, it is valid until the reader is fed again.
+     */
+    BytesAwaiter bytes(size_t size) { return BytesAwaiter(*this, size); }
+
+    /**
+     * @brief Read varint written by Buffer_WriteVarU64
+     *
+     * @throw std::runtime_error when the varint is longer than 10 bytes
+     */
+    ReadTask<uint64_t> varU64()
+    {
+        for (;;) {
+            ConstBuffer view = this->view();
+            uint64_t val = Buffer_ReadVarU64(&view);
+
+            if (view.read != read) {
+                read = view.read;
+                co_return val;
+            }
+            if (available() >= 10) {
+                throw std::runtime_error("invalid varint");
+            }
+            co_await need(available() + 1);
+        }
+    }
+
+private:
+    ConstBuffer view() const
+    {
+        ConstBuffer view;
+
+        view.data = input.data;
+        view.size = input.written;
+        view.read = read;
+        return view;
+    }
+
+    Buffer input;
+    size_t read = 0;
+    size_t needed = 0;
+    bool closed = false;
+    std::coroutine_handle<> waiter;
+};
+
+} // namespace buffer
+
+#endif
+
+#endif /* BUFFER_CORO_HPP */
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#ifndef BUFFER_CPU_H
+#define BUFFER_CPU_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+ * Vector kernels of encoding, byte swapping, column decoding and prefix sums are
+ * selected at runtime by features of the CPU, so a single build runs everywhere.
+ */
+
+enum _bufferCpuLevel {
+    BUFFER_CPU_SCALAR,
+    BUFFER_CPU_SSSE3,
+    BUFFER_CPU_AVX2,
+    BUFFER_CPU_AVX512,
+};
+typedef enum _bufferCpuLevel BufferCpuLevel;
+
+/**
+ * BufferCpu_GetLevel
+ * @return the level of used kernels, the best supported by the CPU unless limited by BufferCpu_SetLevel
+ */
+BufferCpuLevel BufferCpu_GetLevel(void);
+
+/**
+ * @brief Limit used kernels to the level
+ *
+ * Intended for testing and benchmarking, it is not synchronized with running operations.
+ * @param level
+ * @return the level which is used, lower than requested when the CPU does not support it
+ */
+BufferCpuLevel BufferCpu_SetLevel(BufferCpuLevel level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUFFER_CPU_H */
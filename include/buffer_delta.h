@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#ifndef BUFFER_DELTA_H
+#define BUFFER_DELTA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "buffer.h"
+
+/*
+ * Every sequence starts by varint number of values. Differences are computed in two's
+ * complement, so any int64 values can be encoded, small differences take less space.
+ */
+
+/**
+ * @brief Write differences of consecutive values as zigzag varints
+ *
+ * Nothing is written when the sequence does not fit.
+ * @param buff
+ * @param values
+ * @param count
+ */
+void Buffer_WriteDelta(Buffer * buff, const int64_t * values, size_t count);
+
+/**
+ * @brief Read sequence written by Buffer_WriteDelta
+ *
+ * @param buff
+ * @param values
+ * @param maxCount size of values
+ * @param count number of read values
+ * @return false when the sequence is not complete or longer than maxCount, read position is not changed then
+ */
+bool Buffer_ReadDelta(ConstBuffer * buff, int64_t * values, size_t maxCount, size_t * count);
+
+/**
+ * @brief Write differences of consecutive differences as zigzag varints
+ *
+ * The first value and the first difference are stored as they are, values growing
+ * by a steady step, like timestamps, take a byte per value then.
+ * Nothing is written when the sequence does not fit.
+ * @param buff
+ * @param values
+ * @param count
+ */
+void Buffer_WriteDeltaOfDelta(Buffer * buff, const int64_t * values, size_t count);
+
+/**
+ * @brief Read sequence written by Buffer_WriteDeltaOfDelta
+ *
+ * @see Buffer_ReadDelta
+ */
+bool Buffer_ReadDeltaOfDelta(ConstBuffer * buff, int64_t * values, size_t maxCount, size_t * count);
+
+/**
+ * @brief Write differences bit-packed relative to the smallest one (frame of reference)
+ *
+ * Format is varint count, zigzag varint of the first value, zigzag varint of the smallest
+ * difference, uint8 bit width and the differences minus the smallest one packed by bit width
+ * bits, MSB first. Header is omitted for an empty sequence.
+ * Nothing is written when the sequence does not fit.
+ * @param buff
+ * @param values
+ * @param count
+ */
+void Buffer_WriteDeltaPacked(Buffer * buff, const int64_t * values, size_t count);
+
+/**
+ * @brief Read sequence written by Buffer_WriteDeltaPacked
+ *
+ * @see Buffer_ReadDelta
+ */
+bool Buffer_ReadDeltaPacked(ConstBuffer * buff, int64_t * values, size_t maxCount, size_t * count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUFFER_DELTA_H */
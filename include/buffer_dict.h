@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#ifndef BUFFER_DICT_H
+#define BUFFER_DICT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "buffer.h"
+
+/*
+ * String is varint id + 1 when it is in the dictionary, or zero followed by the string
+ * as written by Buffer_WriteStrVar. Both sides add new strings to their dictionaries in
+ * the same order until they are full, so writer and reader of a stream need a dictionary
+ * each, created with the same limits.
+ */
+
+typedef struct _bufferDict BufferDict;
+
+/**
+ * @brief Create dictionary of a stream
+ *
+ * @param maxEntries maximum number of strings
+ * @param maxBytes maximum total size of strings
+ * @return BufferDict or NULL when allocation fails or limits are above 4G
+ */
+BufferDict * BufferDict_Create(size_t maxEntries, size_t maxBytes);
+
+/**
+ * @brief Destroy the dictionary, views returned by Buffer_ReadDictStr are not valid anymore
+ *
+ * @param dict
+ */
+void BufferDict_Destroy(BufferDict * dict);
+
+/**
+ * @brief Remove all strings, for a new stream
+ *
+ * @param dict
+ */
+void BufferDict_Clear(BufferDict * dict);
+
+/**
+ * BufferDict_Count
+ * @param dict
+ * @return the number of strings in the dictionary
+ */
+size_t BufferDict_Count(BufferDict * dict);
+
+/**
+ * @brief Write string by its id, or write it whole and add it to the dictionary
+ *
+ * Nothing is written and nothing is added when it does not fit.
+ * @param buff
+ * @param dict
+ * @param data
+ * @param dataSize
+ */
+void Buffer_WriteDictStr(Buffer * buff, BufferDict * dict, const char * data, size_t dataSize);
+
+/**
+ * @brief Read string written by Buffer_WriteDictStr
+ *
+ * String points inside the dictionary and stays valid until it is cleared or destroyed,
+ * only strings which did not fit to the dictionary point inside the buffer.
+ * @param buff
+ * @param dict
+ * @param str
+ * @return false when the string is not complete or its id is unknown, read position is not changed then
+ */
+bool Buffer_ReadDictStr(ConstBuffer * buff, BufferDict * dict, ConstBuffer * str);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUFFER_DICT_H */
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#ifndef BUFFER_ENCODING_H
+#define BUFFER_ENCODING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "buffer.h"
+
+/**
+ * @brief Write data to the buffer as lowercase hex string
+ *
+ * Writes 2 * dataSize characters without terminating zero. Nothing is written when
+ * the encoded data does not fit.
+ * @param buff
+ * @param data
+ * @param dataSize
+ */
+void Buffer_WriteHex(Buffer * buff, const void * data, size_t dataSize);
+
+/**
+ * @brief Decode hex string from the source buffer to the destination buffer
+ *
+ * Both lowercase and uppercase digits are accepted. On failure read and written
+ * positions are not changed.
+ * @param source
+ * @param destination
+ * @param encodedSize number of characters to decode, must be even
+ * @return false when there is not enough data or space, or the input is not valid
+ */
+bool Buffer_ReadHex(ConstBuffer * source, Buffer * destination, size_t encodedSize);
+
+/**
+ * @brief Write data to the buffer as base64 string (RFC 4648, with padding)
+ *
+ * Writes 4 * ((dataSize + 2) / 3) characters without terminating zero. Nothing is written when
+ * the encoded data does not fit.
+ * @param buff
+ * @param data
+ * @param dataSize
+ */
+void Buffer_WriteBase64(Buffer * buff, const void * data, size_t dataSize);
+
+/**
+ * @brief Decode base64 string from the source buffer to the destination buffer
+ *
+ * Padding is accepted only in the last quantum. On failure read and written
+ * positions are not changed.
+ * @param source
+ * @param destination
+ * @param encodedSize number of characters to decode, must be multiple of 4
+ * @return false when there is not enough data or space, or the input is not valid
+ */
+bool Buffer_ReadBase64(ConstBuffer * source, Buffer * destination, size_t encodedSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUFFER_ENCODING_H */
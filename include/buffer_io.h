@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#ifndef BUFFER_IO_H
+#define BUFFER_IO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "buffer.h"
+
+typedef struct _bufferIo BufferIo;
+
+enum _bufferIoBackend {
+    BUFFER_IO_AUTO,
+    BUFFER_IO_URING,
+    BUFFER_IO_THREAD,
+};
+typedef enum _bufferIoBackend BufferIoBackend;
+
+/**
+ * @brief Completion callback
+ *
+ * Called from BufferIo_Poll, buffer positions are already updated, so the buffer
+ * may be reused or returned to its pool right away.
+ * @param ctx
+ * @param result number of transferred bytes or negative errno
+ */
+typedef void (*BufferIoCallback)(void * ctx, long result);
+
+/**
+ * @brief Create asynchronous I/O queue
+ *
+ * io_uring is used on Linux 5.6 and newer, otherwise requests are processed by background
+ * threads with blocking calls. A thread is started whenever all of them are blocked, up to
+ * queueDepth, so a read waiting for a peer does not hold back other requests. The queue is
+ * not thread-safe, submit and poll from a single thread.
+ * @param queueDepth maximum number of requests in flight
+ * @param backend BUFFER_IO_AUTO to select the best available
+ * @return BufferIo or NULL when the backend is not available
+ */
+BufferIo * BufferIo_Create(unsigned queueDepth, BufferIoBackend backend);
+
+/**
+ * @brief Wait for all requests in flight and destroy the queue
+ *
+ * Callbacks of the remaining requests are called. Requests which the kernel keeps refusing
+ * to accept are completed with -ECANCELED after a bounded number of retries.
+ * @param io
+ */
+void BufferIo_Destroy(BufferIo * io);
+
+/**
+ * @brief Get used backend
+ *
+ * @param io
+ * @return BUFFER_IO_URING or BUFFER_IO_THREAD
+ */
+BufferIoBackend BufferIo_GetBackend(BufferIo * io);
+
+/**
+ * @brief Register buffers for fixed buffer I/O
+ *
+ * Requests on data of the registered buffers skip page pinning with io_uring, other
+ * backends ignore the registration. Buffers must stay allocated until the queue is destroyed.
+ * @param io
+ * @param buffs
+ * @param count
+ * @return false when registration fails
+ */
+bool BufferIo_RegisterBuffers(BufferIo * io, const Buffer * buffs, size_t count);
+
+/**
+ * @brief Queue write of written data of the buffer
+ *
+ * Requests are queued without a system call, they are submitted by BufferIo_Flush or
+ * BufferIo_Poll. Requests to the same file descriptor are not ordered with io_uring,
+ * when order matters, submit the next write from the callback.
+ * @param io
+ * @param fd
+ * @param offset file offset or -1 for the current position (pipes and sockets)
+ * @param buff must stay valid until the callback
+ * @param callback may be NULL
+ * @param ctx
+ * @return false when the queue is full
+ */
+bool BufferIo_SubmitWrite(BufferIo * io, int fd, int64_t offset, Buffer * buff, BufferIoCallback callback, void * ctx);
+
+/**
+ * @brief Queue write of unread data of the buffer
+ *
+ * Read position is moved by the written bytes before the callback.
+ * @see BufferIo_SubmitWrite
+ */
+bool BufferIo_SubmitWriteConst(BufferIo * io, int fd, int64_t offset, ConstBuffer * buff, BufferIoCallback callback, void * ctx);
+
+/**
+ * @brief Queue read to free space of the buffer
+ *
+ * Written bytes are increased by the read bytes before the callback.
+ * @see BufferIo_SubmitWrite
+ */
+bool BufferIo_SubmitRead(BufferIo * io, int fd, int64_t offset, Buffer * buff, BufferIoCallback callback, void * ctx);
+
+/**
+ * @brief Submit all queued requests at once
+ *
+ * When the kernel can not accept more requests, completions are reaped and their callbacks
+ * are called. Requests which are still not accepted stay queued for the next flush or poll.
+ * @param io
+ * @return number of submitted requests
+ */
+size_t BufferIo_Flush(BufferIo * io);
+
+/**
+ * @brief Submit queued requests and call callbacks of completed ones
+ *
+ * @param io
+ * @param wait block until at least one request completes, when some were accepted by the kernel
+ * @return number of completed requests
+ */
+size_t BufferIo_Poll(BufferIo * io, bool wait);
+
+/**
+ * BufferIo_InFlight
+ * @param io
+ * @return the number of requests which were not completed yet
+ */
+size_t BufferIo_InFlight(BufferIo * io);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUFFER_IO_H */
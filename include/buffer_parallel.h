@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#ifndef BUFFER_PARALLEL_H
+#define BUFFER_PARALLEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "buffer.h"
+
+typedef struct _bufferWorkers BufferWorkers;
+
+/**
+ * @brief Start worker threads for parallel encoding
+ *
+ * The calling thread takes part in the work too, so threads - 1 workers are started.
+ * Functions of this module accept NULL workers and run on the calling thread only.
+ * @param threads total number of threads, at most 64
+ * @return BufferWorkers or NULL when threads are not supported or can not be started
+ */
+BufferWorkers * BufferWorkers_Create(unsigned threads);
+
+/**
+ * @brief Stop worker threads
+ *
+ * @param workers
+ */
+void BufferWorkers_Destroy(BufferWorkers * workers);
+
+/**
+ * @brief Write array of unsigned integers to the buffer in big endian
+ *
+ * Nothing is written when the whole array does not fit.
+ * @param buff
+ * @param data array of uint8_t, uint16_t, uint32_t or uint64_t
+ * @param count number of elements
+ * @param elemSize size of element, 1, 2, 4 or 8
+ */
+void Buffer_WriteArray(Buffer * buff, const void * data, size_t count, size_t elemSize);
+
+/**
+ * @brief Read array of big endian unsigned integers from the buffer
+ *
+ * @param buff
+ * @param data array of uint8_t, uint16_t, uint32_t or uint64_t
+ * @param count number of elements
+ * @param elemSize size of element, 1, 2, 4 or 8
+ * @return false when there is not enough data
+ */
+bool Buffer_ReadArray(ConstBuffer * buff, void * data, size_t count, size_t elemSize);
+
+/**
+ * @brief Write array of unsigned integers by all workers
+ *
+ * Same as Buffer_WriteArray, every thread encodes its own part of the output region.
+ * Workers must not be used from more threads at once.
+ * @param workers
+ * @param buff
+ * @param data
+ * @param count
+ * @param elemSize
+ */
+void Buffer_WriteArrayParallel(BufferWorkers * workers, Buffer * buff, const void * data, size_t count, size_t elemSize);
+
+/**
+ * @brief Read array of unsigned integers by all workers
+ *
+ * @param workers
+ * @param buff
+ * @param data
+ * @param count
+ * @param elemSize
+ * @return false when there is not enough data
+ */
+bool Buffer_ReadArrayParallel(BufferWorkers * workers, ConstBuffer * buff, void * data, size_t count, size_t elemSize);
+
+/**
+ * @brief Write array of uint64 as varints by all workers
+ *
+ * Encoded length of every part is computed first, offsets of the parts are their prefix sum.
+ * Nothing is written when the whole array does not fit.
+ * @param workers
+ * @param buff
+ * @param data
+ * @param count
+ * @return number of written bytes
+ * @see Buffer_WriteVarU64
+ */
+size_t Buffer_WriteVarArrayParallel(BufferWorkers * workers, Buffer * buff, const uint64_t * data, size_t count);
+
+/**
+ * @brief Read array of varints by all workers
+ *
+ * Input is split to parts by bytes, terminating bytes of varints in every part are counted
+ * to find index of the first value of the part.
+ * @param workers
+ * @param buff
+ * @param data
+ * @param count number of values
+ * @param encodedSize number of bytes taken by the values
+ * @return false when data are not exactly count varints
+ */
+bool Buffer_ReadVarArrayParallel(BufferWorkers * workers, ConstBuffer * buff, uint64_t * data, size_t count, size_t encodedSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUFFER_PARALLEL_H */
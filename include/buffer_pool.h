@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "buffer.h"
+
+typedef struct _bufferPool BufferPool;
+
+struct _bufferPoolStats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t releases;
+    uint64_t drops;
+    size_t cached;
+};
+typedef struct _bufferPoolStats BufferPoolStats;
+
+/**
+ * @brief Create pool of reusable buffers
+ *
+ * Buffers are kept in power of two size classes from minSize up to maxSize. Every class
+ * caches at most slotsPerClass free buffers in a lock-free LIFO list, so the most recently
+ * released (cache warm) buffer is handed out first. Buffers can be acquired and released
+ * from any thread.
+ *
+ * Lists use 64-bit atomics where they are lock-free (ATOMIC_LLONG_LOCK_FREE), elsewhere
+ * slotsPerClass is limited to 65534 and statistics counters wrap at 32 bits.
+ * @param minSize size of the smallest class, rounded up to power of two
+ * @param maxSize size of the largest class, rounded up to power of two
+ * @param slotsPerClass
+ * @return BufferPool or NULL when allocation fails or slotsPerClass is too big
+ */
+BufferPool * BufferPool_Create(size_t minSize, size_t maxSize, size_t slotsPerClass);
+
+/**
+ * @brief Destroy the pool and free all cached buffers
+ *
+ * Buffers which are still acquired are not tracked by the pool, release them by Buffer_FreeData.
+ * @param pool
+ */
+void BufferPool_Destroy(BufferPool * pool);
+
+/**
+ * @brief Acquire buffer with at least size bytes
+ *
+ * Size of the returned buffer is the size of its class. Requests bigger than the largest class
+ * are allocated directly.
+ * @param pool
+ * @param size
+ * @return Buffer, data is NULL when allocation fails
+ */
+Buffer BufferPool_Acquire(BufferPool * pool, size_t size);
+
+/**
+ * @brief Return buffer to the pool
+ *
+ * Buffer may be released from any thread. When its class is full or the buffer does not belong
+ * to any class, data are freed.
+ * @param pool
+ * @param buff
+ */
+void BufferPool_Release(BufferPool * pool, Buffer * buff);
+
+/**
+ * @brief Get pool statistics
+ *
+ * @param pool
+ * @param stats
+ */
+void BufferPool_GetStats(BufferPool * pool, BufferPoolStats * stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUFFER_POOL_H */
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#ifndef BUFFER_SIZING_H
+#define BUFFER_SIZING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "buffer.h"
+
+typedef struct _bufferSizer BufferSizer;
+
+/**
+ * @brief Create sizing advisor of a channel
+ *
+ * Sizes of messages are counted in a histogram with logarithmic buckets (four per power
+ * of two), so suggestions are rounded up by at most a quarter. Counts are halved every few
+ * thousand samples, so suggestions follow changes of the workload. Keep one advisor per call
+ * site or channel, sizes can be recorded from any thread.
+ * @param name name of the channel, it is not copied
+ * @param minSize the smallest suggested size, also used when nothing was recorded yet
+ * @param maxSize the largest suggested size
+ * @param percentile percentile of recorded sizes to suggest, e.g. 99.0
+ * @return BufferSizer or NULL when allocation fails or parameters are not valid
+ */
+BufferSizer * BufferSizer_Create(const char * name, size_t minSize, size_t maxSize, double percentile);
+
+/**
+ * @brief Destroy the advisor
+ *
+ * @param sizer
+ */
+void BufferSizer_Destroy(BufferSizer * sizer);
+
+/**
+ * BufferSizer_GetName
+ * @param sizer
+ * @return name of the channel
+ */
+const char * BufferSizer_GetName(BufferSizer * sizer);
+
+/**
+ * @brief Record size of a message
+ *
+ * When writes did not fit, record the size which would be needed.
+ * @param sizer
+ * @param size
+ */
+void BufferSizer_Record(BufferSizer * sizer, size_t size);
+
+/**
+ * @brief Get size at the percentile given at creation
+ *
+ * @param sizer
+ * @return size between minSize and maxSize
+ */
+size_t BufferSizer_Suggest(BufferSizer * sizer);
+
+/**
+ * @brief Get size at any percentile
+ *
+ * @param sizer
+ * @param percentile
+ * @return upper bound of the bucket at the percentile, not clamped, zero when nothing was recorded
+ */
+size_t BufferSizer_Percentile(BufferSizer * sizer, double percentile);
+
+/**
+ * @brief Allocate buffer of the suggested size
+ *
+ * @param sizer
+ * @return Buffer, data is NULL when allocation fails
+ */
+Buffer BufferSizer_Alloc(BufferSizer * sizer);
+
+/**
+ * @brief Record written bytes of the buffer and free its data
+ *
+ * @param sizer
+ * @param buff
+ */
+void BufferSizer_Free(BufferSizer * sizer, Buffer * buff);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUFFER_SIZING_H */
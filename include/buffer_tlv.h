@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#ifndef BUFFER_TLV_H
+#define BUFFER_TLV_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "buffer.h"
+
+/*
+ * Field is uint8 tag, uint16 length and the value.
+ */
+
+struct _tlvIndex {
+    uint32_t offsets[256];
+};
+typedef struct _tlvIndex TlvIndex;
+
+/**
+ * @brief Write TLV field to the buffer
+ *
+ * Nothing is written when the value is longer than 65535 bytes or the field does not fit.
+ * @param buff
+ * @param tag
+ * @param data
+ * @param dataSize
+ */
+void Buffer_WriteTlv(Buffer * buff, uint8_t tag, const void * data, size_t dataSize);
+
+/**
+ * @brief Read next TLV field from the buffer
+ *
+ * Value is not copied, it points inside the buffer.
+ * @param buff
+ * @param tag
+ * @param value
+ * @return false when the field is not complete, read position is not changed then
+ */
+bool Buffer_ReadTlv(ConstBuffer * buff, uint8_t * tag, ConstBuffer * value);
+
+/**
+ * @brief Index fields of the record by their tags
+ *
+ * Unread data of the record are walked once, offset of the first field of every tag
+ * is stored, so later lookups do not scan the record again.
+ * @param index
+ * @param record
+ * @return false when the record does not consist of complete fields or is larger than 4 GB
+ */
+bool TlvIndex_Build(TlvIndex * index, const ConstBuffer * record);
+
+/**
+ * @brief Get value of the field with the tag
+ *
+ * @param index
+ * @param record the same record the index was built for
+ * @param tag
+ * @param value points inside the record
+ * @return false when there is no such field
+ */
+bool TlvIndex_Get(const TlvIndex * index, const ConstBuffer * record, uint8_t tag, ConstBuffer * value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUFFER_TLV_H */
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#ifndef SHARED_BUFFER_H
+#define SHARED_BUFFER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "buffer.h"
+
+typedef struct _sharedBuffer SharedBuffer;
+
+struct _sharedConstBuffer {
+    ConstBuffer buff;
+    SharedBuffer * owner;
+};
+typedef struct _sharedConstBuffer SharedConstBuffer;
+
+/**
+ * @brief Allocate reference counted buffer
+ *
+ * Header and data are allocated at once. The caller holds the first reference.
+ * @param size
+ * @return SharedBuffer or NULL when allocation fails
+ */
+SharedBuffer * SharedBuffer_Alloc(size_t size);
+
+/**
+ * @brief Get the buffer for writing
+ *
+ * Data must be written before the buffer is shared, shared data are read only.
+ * @param shared
+ * @return Buffer
+ */
+Buffer * SharedBuffer_GetBuffer(SharedBuffer * shared);
+
+/**
+ * @brief Create read handle to the written data
+ *
+ * The handle holds its own reference and read position, so it may be passed to another thread.
+ * @param shared
+ * @return SharedConstBuffer
+ */
+SharedConstBuffer SharedBuffer_Share(SharedBuffer * shared);
+
+/**
+ * @brief Drop reference, data are freed with the last one
+ *
+ * @param shared
+ */
+void SharedBuffer_Release(SharedBuffer * shared);
+
+/**
+ * @brief Create another handle to the same data with read position reset
+ *
+ * @param handle
+ * @return SharedConstBuffer
+ */
+SharedConstBuffer SharedConstBuffer_Copy(const SharedConstBuffer * handle);
+
+/**
+ * @brief Release the handle
+ *
+ * @param handle
+ */
+void SharedConstBuffer_Release(SharedConstBuffer * handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHARED_BUFFER_H */
@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#include "bit_buffer.h"
+
+#define BIT_MASK(count) (((uint64_t)1 << (count)) - 1)
+
+BitBuffer BitBuffer_Init(Buffer * buff, BitOrder order)
+{
+    BitBuffer result = {
+            .buff = buff,
+            .order = order,
+    };
+    return result;
+}
+
+static void Bits_WriteLE32(Buffer * buff, uint32_t val)
+{
+    uint8_t bytes[4] = {
+            (uint8_t)val,
+            (uint8_t)(val >> 8),
+            (uint8_t)(val >> 16),
+            (uint8_t)(val >> 24),
+    };
+    Buffer_Write(buff, bytes, sizeof(bytes));
+}
+
+/* count <= 32, accumulator holds less than 32 bits before and after the call */
+static void Bits_Put(BitBuffer * bits, uint32_t val, uint8_t count)
+{
+    if (bits->order == BIT_ORDER_MSB_FIRST) {
+        bits->acc = (bits->acc << count) | val;
+        bits->bits += count;
+        if (bits->bits >= 32) {
+            bits->bits -= 32;
+            Buffer_WriteU32(bits->buff, (uint32_t)(bits->acc >> bits->bits));
+            bits->acc &= BIT_MASK(bits->bits);
+        }
+    } else {
+        bits->acc |= (uint64_t)val << bits->bits;
+        bits->bits += count;
+        if (bits->bits >= 32) {
+            bits->bits -= 32;
+            Bits_WriteLE32(bits->buff, (uint32_t)bits->acc);
+            bits->acc >>= 32;
+        }
+    }
+}
+
+void BitBuffer_Write(BitBuffer * bits, uint64_t val, uint8_t count)
+{
+    if (count > 64) {
+        return;
+    }
+    if (count < 64) {
+        val &= BIT_MASK(count);
+    }
+
+    if (count <= 32) {
+        Bits_Put(bits, (uint32_t)val, count);
+    } else if (bits->order == BIT_ORDER_MSB_FIRST) {
+        Bits_Put(bits, (uint32_t)(val >> 32), count - 32);
+        Bits_Put(bits, (uint32_t)val, 32);
+    } else {
+        Bits_Put(bits, (uint32_t)val, 32);
+        Bits_Put(bits, (uint32_t)(val >> 32), count - 32);
+    }
+}
+
+void BitBuffer_Flush(BitBuffer * bits)
+{
+    if (bits->order == BIT_ORDER_MSB_FIRST) {
+        while (bits->bits >= 8) {
+            bits->bits -= 8;
+            Buffer_WriteU8(bits->buff, (uint8_t)(bits->acc >> bits->bits));
+        }
+        if (bits->bits > 0) {
+            Buffer_WriteU8(bits->buff, (uint8_t)(bits->acc << (8 - bits->bits)));
+        }
+    } else {
+        while (bits->bits > 0) {
+            Buffer_WriteU8(bits->buff, (uint8_t)bits->acc);
+            bits->acc >>= 8;
+            bits->bits = bits->bits > 8 ? bits->bits - 8 : 0;
+        }
+    }
+
+    bits->acc = 0;
+    bits->bits = 0;
+}
+
+ConstBitBuffer ConstBitBuffer_Init(ConstBuffer * buff, BitOrder order)
+{
+    ConstBitBuffer result = {
+            .buff = buff,
+            .order = order,
+    };
+    return result;
+}
+
+static uint32_t Bits_ReadLE32(ConstBuffer * buff)
+{
+    const uint8_t * data = buff->data + buff->read;
+
+    buff->read += 4;
+    return (uint32_t)data[0] | (uint32_t)data[1] << 8 | (uint32_t)data[2] << 16 | (uint32_t)data[3] << 24;
+}
+
+static void Bits_Refill(ConstBitBuffer * bits)
+{
+    if (bits->bits <= 32 && Buffer_ReadAvailable(bits->buff) >= 4) {
+        if (bits->order == BIT_ORDER_MSB_FIRST) {
+            bits->acc = (bits->acc << 32) | Buffer_ReadU32(bits->buff);
+        } else {
+            bits->acc |= (uint64_t)Bits_ReadLE32(bits->buff) << bits->bits;
+        }
+        bits->bits += 32;
+        return;
+    }
+
+    while (bits->bits <= 56 && Buffer_ReadAvailable(bits->buff) > 0) {
+        if (bits->order == BIT_ORDER_MSB_FIRST) {
+            bits->acc = (bits->acc << 8) | Buffer_ReadU8(bits->buff);
+        } else {
+            bits->acc |= (uint64_t)Buffer_ReadU8(bits->buff) << bits->bits;
+        }
+        bits->bits += 8;
+    }
+}
+
+/* count <= 32 */
+static uint32_t Bits_Get(ConstBitBuffer * bits, uint8_t count)
+{
+    uint32_t result;
+
+    if (bits->bits < count) {
+        Bits_Refill(bits);
+    }
+
+    if (bits->order == BIT_ORDER_MSB_FIRST) {
+        bits->bits -= count;
+        result = (uint32_t)((bits->acc >> bits->bits) & BIT_MASK(count));
+    } else {
+        result = (uint32_t)(bits->acc & BIT_MASK(count));
+        bits->acc >>= count;
+        bits->bits -= count;
+    }
+    return result;
+}
+
+uint64_t BitBuffer_Read(ConstBitBuffer * bits, uint8_t count)
+{
+    uint64_t result;
+
+    if (count > 64 || BitBuffer_ReadAvailable(bits) < count) {
+        return 0;
+    }
+
+    if (count <= 32) {
+        return Bits_Get(bits, count);
+    }
+
+    if (bits->order == BIT_ORDER_MSB_FIRST) {
+        result = (uint64_t)Bits_Get(bits, count - 32) << 32;
+        result |= Bits_Get(bits, 32);
+    } else {
+        result = Bits_Get(bits, 32);
+        result |= (uint64_t)Bits_Get(bits, count - 32) << 32;
+    }
+    return result;
+}
+
+size_t BitBuffer_ReadAvailable(ConstBitBuffer * bits)
+{
+    return bits->bits + 8 * Buffer_ReadAvailable(bits->buff);
+}
+
+void BitBuffer_ReadAlign(ConstBitBuffer * bits)
+{
+    bits->buff->read -= bits->bits / 8;
+    bits->acc = 0;
+    bits->bits = 0;
+}
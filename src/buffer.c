@@ -1,6 +1,10 @@
 // SPDX-License-Identifier: MIT
 // Author: ELEKON, s.r.o., Vyškov
 
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
 #include "buffer.h"
 
 #include <string.h>
@@ -8,22 +12,248 @@
 #include <stdarg.h>
 #include <stdlib.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define BUFFER_HAVE_MMAN
+#elif defined(_WIN32)
+#include <malloc.h>
+#endif
+
 #include "serde.h"
 
+/* streaming stores are dispatched by buffer_cpu.c on x86, elsewhere buffer.c stands alone */
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include "buffer_kernels.h"
+#define BUFFER_HAVE_NON_TEMPORAL
+#endif
+
+#ifndef BUFFER_HUGE_PAGE_SIZE
+#define BUFFER_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#endif
+
+/* streaming smaller data is not worth it, they are likely to stay in cache anyway */
+#ifndef BUFFER_NON_TEMPORAL_MIN
+#define BUFFER_NON_TEMPORAL_MIN (256 * 1024)
+#endif
+
+#define BUFFER_ROUND_UP(size, granule) (((size) + (granule) - 1) / (granule) * (granule))
+
 Buffer Buffer_AllocData(size_t size)
 {
     Buffer result = {
             .data = malloc(size),
             .size = size,
+            .alloc = BUFFER_ALLOC_HEAP,
     };
     return result;
 }
 
+static void Buffer_Prefault(void * data, size_t size)
+{
+#ifdef BUFFER_HAVE_MMAN
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+#else
+    /* the smallest page of supported platforms */
+    size_t page = 4096;
+#endif
+
+    /* writing a byte per page is enough to fault the page in */
+    for (size_t i = 0; i < size; i += page) {
+        ((volatile uint8_t *)data)[i] = 0;
+    }
+}
+
+#ifdef BUFFER_HAVE_MMAN
+static Buffer Buffer_MapData(size_t size, const BufferAllocOptions * options)
+{
+    Buffer result = {
+            .alloc = BUFFER_ALLOC_MAPPED,
+    };
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    size_t mapped;
+    size_t head;
+    void * data;
+
+#ifdef MAP_HUGETLB
+    int hugeFlags = flags | MAP_HUGETLB;
+
+#ifdef MAP_POPULATE
+    if (options->prefault) {
+        hugeFlags |= MAP_POPULATE;
+    }
+#endif
+
+    mapped = BUFFER_ROUND_UP(size, BUFFER_HUGE_PAGE_SIZE);
+    data = mmap(NULL, mapped, PROT_READ | PROT_WRITE, hugeFlags, -1, 0);
+    if (data != MAP_FAILED) {
+        result.data = data;
+        result.size = mapped;
+        return result;
+    }
+#endif
+
+    /*
+     * huge pages are not reserved, fall back to transparent huge pages, which back only
+     * huge page aligned ranges, so map one huge page more and trim the mapping to aligned start,
+     * pages are touched only after madvise, otherwise they would be faulted in as small pages
+     */
+    mapped = BUFFER_ROUND_UP(size, (size_t)sysconf(_SC_PAGESIZE));
+    if (mapped < size || mapped > SIZE_MAX - BUFFER_HUGE_PAGE_SIZE) {
+        return result;
+    }
+    data = mmap(NULL, mapped + BUFFER_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (data == MAP_FAILED) {
+        return result;
+    }
+
+    head = BUFFER_ROUND_UP((uintptr_t)data, BUFFER_HUGE_PAGE_SIZE) - (uintptr_t)data;
+    if (head > 0) {
+        munmap(data, head);
+    }
+    munmap((uint8_t *)data + head + mapped, BUFFER_HUGE_PAGE_SIZE - head);
+    data = (uint8_t *)data + head;
+
+#ifdef MADV_HUGEPAGE
+    madvise(data, mapped, MADV_HUGEPAGE);
+#endif
+    if (options->prefault) {
+        Buffer_Prefault(data, mapped);
+    }
+
+    result.data = data;
+    result.size = mapped;
+    return result;
+}
+#endif
+
+Buffer Buffer_AllocDataEx(size_t size, const BufferAllocOptions * options)
+{
+    Buffer result = {0};
+
+    if (options == NULL || (options->alignment == 0 && !options->hugePages && !options->prefault)) {
+        return Buffer_AllocData(size);
+    }
+
+    if (options->alignment & (options->alignment - 1)) {
+        return result;
+    }
+
+#ifdef BUFFER_HAVE_MMAN
+    if (options->hugePages && options->alignment <= (size_t)sysconf(_SC_PAGESIZE)) {
+        result = Buffer_MapData(size, options);
+        if (result.data != NULL) {
+            return result;
+        }
+    }
+#endif
+
+    if (options->alignment > 0) {
+        size_t alignment = options->alignment < sizeof(void *) ? sizeof(void *) : options->alignment;
+        void * data = NULL;
+
+#if defined(BUFFER_HAVE_MMAN)
+        if (posix_memalign(&data, alignment, size) != 0) {
+            data = NULL;
+        }
+#elif defined(_WIN32)
+        data = _aligned_malloc(size, alignment);
+#else
+        data = aligned_alloc(alignment, BUFFER_ROUND_UP(size, alignment));
+#endif
+        result.data = data;
+        result.alloc = BUFFER_ALLOC_ALIGNED;
+    } else {
+        result.data = malloc(size);
+    }
+
+    if (result.data == NULL) {
+        return result;
+    }
+    result.size = size;
+
+    if (options->prefault) {
+        Buffer_Prefault(result.data, size);
+    }
+
+    return result;
+}
+
 void Buffer_FreeData(Buffer * buff)
 {
-    free(buff->data);
+    switch (buff->alloc) {
+#ifdef BUFFER_HAVE_MMAN
+    case BUFFER_ALLOC_MAPPED:
+        if (buff->data != NULL) {
+            munmap(buff->data, buff->size);
+        }
+        break;
+#endif
+#ifdef _WIN32
+    case BUFFER_ALLOC_ALIGNED:
+        _aligned_free(buff->data);
+        break;
+#endif
+    case BUFFER_ALLOC_STATIC:
+    case BUFFER_ALLOC_NONE:
+        break;
+    default:
+        free(buff->data);
+        break;
+    }
     buff->data = NULL;
     buff->size = 0;
+    buff->alloc = BUFFER_ALLOC_HEAP;
+}
+
+void Buffer_InitStatic(Buffer * buff, void * data, size_t size)
+{
+    buff->data = data;
+    buff->size = size;
+    buff->written = 0;
+    buff->alloc = BUFFER_ALLOC_STATIC;
+}
+
+bool Buffer_Reserve(Buffer * buff, size_t size)
+{
+    size_t newSize;
+    uint8_t * data;
+
+    if (Buffer_WriteAvailable(buff) >= size) {
+        return true;
+    }
+    if (size > SIZE_MAX - buff->written) {
+        return false;
+    }
+
+    /* grow at least twice to keep the number of reallocations low */
+    newSize = buff->written + size;
+    if (buff->size <= SIZE_MAX / 2 && newSize < buff->size * 2) {
+        newSize = buff->size * 2;
+    }
+
+    switch (buff->alloc) {
+    case BUFFER_ALLOC_HEAP:
+        data = realloc(buff->data, newSize);
+        break;
+    case BUFFER_ALLOC_STATIC:
+        data = malloc(newSize);
+        if (data != NULL && buff->written > 0) {
+            memcpy(data, buff->data, buff->written);
+        }
+        break;
+    default:
+        return false;
+    }
+
+    if (data == NULL) {
+        return false;
+    }
+
+    buff->data = data;
+    buff->size = newSize;
+    buff->alloc = BUFFER_ALLOC_HEAP;
+    return true;
 }
 
 size_t Buffer_WriteAvailable(Buffer * buff)
@@ -114,6 +344,20 @@ void Buffer_WriteS8(Buffer * buff, int8_t val)
     buff->written += sizeof(val);
 }
 
+void Buffer_WriteVarU64(Buffer * buff, uint64_t val)
+{
+    uint8_t bytes[10];
+    size_t size = 0;
+
+    while (val >= 0x80) {
+        bytes[size++] = (uint8_t)val | 0x80;
+        val >>= 7;
+    }
+    bytes[size++] = (uint8_t)val;
+
+    Buffer_Write(buff, bytes, size);
+}
+
 void Buffer_WriteStr(Buffer * buff, const char * data, size_t dataSize)
 {
     if (buff->written + dataSize > buff->size) {
@@ -123,6 +367,49 @@ void Buffer_WriteStr(Buffer * buff, const char * data, size_t dataSize)
     buff->written += dataSize;
 }
 
+static void Buffer_WritePrefixed(Buffer * buff, const uint8_t * prefix, size_t prefixSize, const char * data, size_t dataSize)
+{
+    if (dataSize > SIZE_MAX - prefixSize || prefixSize + dataSize > Buffer_WriteAvailable(buff)) {
+        return;
+    }
+    memcpy(buff->data + buff->written, prefix, prefixSize);
+    memcpy(buff->data + buff->written + prefixSize, data, dataSize);
+    buff->written += prefixSize + dataSize;
+}
+
+void Buffer_WriteStr8(Buffer * buff, const char * data, size_t dataSize)
+{
+    uint8_t prefix = (uint8_t)dataSize;
+
+    if (dataSize > UINT8_MAX) {
+        return;
+    }
+    Buffer_WritePrefixed(buff, &prefix, sizeof(prefix), data, dataSize);
+}
+
+void Buffer_WriteStr16(Buffer * buff, const char * data, size_t dataSize)
+{
+    uint8_t prefix[2];
+
+    if (dataSize > UINT16_MAX) {
+        return;
+    }
+    Serde_BE_UInt16ToBytes(prefix, (uint16_t)dataSize);
+    Buffer_WritePrefixed(buff, prefix, sizeof(prefix), data, dataSize);
+}
+
+void Buffer_WriteStrVar(Buffer * buff, const char * data, size_t dataSize)
+{
+    uint8_t prefix[10];
+    Buffer prefixBuffer = {
+            .data = prefix,
+            .size = sizeof(prefix),
+    };
+
+    Buffer_WriteVarU64(&prefixBuffer, dataSize);
+    Buffer_WritePrefixed(buff, prefix, prefixBuffer.written, data, dataSize);
+}
+
 void Buffer_Write(Buffer * buff, const void * data, size_t dataSize)
 {
     if (buff->written + dataSize > buff->size) {
@@ -132,6 +419,27 @@ void Buffer_Write(Buffer * buff, const void * data, size_t dataSize)
     buff->written += dataSize;
 }
 
+static void Buffer_CopyNonTemporal(uint8_t * dst, const uint8_t * src, size_t size)
+{
+    size_t copied = 0;
+
+#ifdef BUFFER_HAVE_NON_TEMPORAL
+    if (size >= BUFFER_NON_TEMPORAL_MIN) {
+        copied = Buffer_GetKernels()->copyNonTemporal(dst, src, size);
+    }
+#endif
+    memcpy(dst + copied, src + copied, size - copied);
+}
+
+void Buffer_WriteNonTemporal(Buffer * buff, const void * data, size_t dataSize)
+{
+    if (buff->written + dataSize > buff->size) {
+        return;
+    }
+    Buffer_CopyNonTemporal(buff->data + buff->written, data, dataSize);
+    buff->written += dataSize;
+}
+
 void Buffer_Clear(Buffer * buff)
 {
     buff->written = 0;
@@ -155,6 +463,51 @@ size_t Buffer_ReadAvailable(ConstBuffer * buff)
     return 0;
 }
 
+size_t ConstBuffer_Mark(ConstBuffer * buff)
+{
+    return buff->read;
+}
+
+void ConstBuffer_Rewind(ConstBuffer * buff, size_t mark)
+{
+    if (mark > buff->read) {
+        return;
+    }
+    buff->read = mark;
+}
+
+uint64_t Buffer_PeekU64(ConstBuffer * buff)
+{
+    if (buff->read + sizeof(uint64_t) > buff->size) {
+        return 0;
+    }
+    return Serde_BE_BytesToUInt64(buff->data + buff->read);
+}
+
+uint32_t Buffer_PeekU32(ConstBuffer * buff)
+{
+    if (buff->read + sizeof(uint32_t) > buff->size) {
+        return 0;
+    }
+    return Serde_BE_BytesToUInt32(buff->data + buff->read);
+}
+
+uint16_t Buffer_PeekU16(ConstBuffer * buff)
+{
+    if (buff->read + sizeof(uint16_t) > buff->size) {
+        return 0;
+    }
+    return Serde_BE_BytesToUInt16(buff->data + buff->read);
+}
+
+uint8_t Buffer_PeekU8(ConstBuffer * buff)
+{
+    if (buff->read + sizeof(uint8_t) > buff->size) {
+        return 0;
+    }
+    return buff->data[buff->read];
+}
+
 uint64_t Buffer_ReadU64(ConstBuffer * buff)
 {
     uint64_t res = 0;
@@ -251,6 +604,69 @@ int8_t Buffer_ReadS8(ConstBuffer * buff)
     return res;
 }
 
+uint64_t Buffer_ReadVarU64(ConstBuffer * buff)
+{
+    uint64_t res = 0;
+    size_t i;
+
+    for (i = 0; i < 10 && buff->read + i < buff->size; i++) {
+        uint8_t byte = buff->data[buff->read + i];
+
+        /* the 10th byte holds only the top bit of 64-bit value */
+        if (i == 9 && byte > 1) {
+            return 0;
+        }
+        res |= (uint64_t)(byte & 0x7f) << (7 * i);
+        if ((byte & 0x80) == 0) {
+            buff->read += i + 1;
+            return res;
+        }
+    }
+    return 0;
+}
+
+static bool Buffer_ReadSized(ConstBuffer * buff, size_t mark, size_t size, ConstBuffer * str)
+{
+    if (buff->read == mark || size > Buffer_ReadAvailable(buff)) {
+        buff->read = mark;
+        return false;
+    }
+
+    str->data = buff->data + buff->read;
+    str->size = size;
+    str->read = 0;
+    buff->read += size;
+    return true;
+}
+
+bool Buffer_ReadStr8(ConstBuffer * buff, ConstBuffer * str)
+{
+    size_t mark = buff->read;
+    size_t size = Buffer_ReadU8(buff);
+
+    return Buffer_ReadSized(buff, mark, size, str);
+}
+
+bool Buffer_ReadStr16(ConstBuffer * buff, ConstBuffer * str)
+{
+    size_t mark = buff->read;
+    size_t size = Buffer_ReadU16(buff);
+
+    return Buffer_ReadSized(buff, mark, size, str);
+}
+
+bool Buffer_ReadStrVar(ConstBuffer * buff, ConstBuffer * str)
+{
+    size_t mark = buff->read;
+    uint64_t size = Buffer_ReadVarU64(buff);
+
+    if (size > SIZE_MAX) {
+        buff->read = mark;
+        return false;
+    }
+    return Buffer_ReadSized(buff, mark, (size_t)size, str);
+}
+
 bool Buffer_Read(ConstBuffer * source, void * destination, size_t destinationSize)
 {
     if (source->read + destinationSize > source->size) {
@@ -261,6 +677,16 @@ bool Buffer_Read(ConstBuffer * source, void * destination, size_t destinationSiz
     return true;
 }
 
+bool Buffer_ReadNonTemporal(ConstBuffer * source, void * destination, size_t destinationSize)
+{
+    if (source->read + destinationSize > source->size) {
+        return false;
+    }
+    Buffer_CopyNonTemporal(destination, source->data + source->read, destinationSize);
+    source->read += destinationSize;
+    return true;
+}
+
 size_t Buffer_Format(Buffer * buff, const char * format, ...)
 {
     size_t result;
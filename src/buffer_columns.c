@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#include "buffer_columns.h"
+
+#include <string.h>
+
+#include "serde.h"
+
+#include "buffer_kernels.h"
+
+/* records decoded field by field at once, block should fit in L1 cache */
+#ifndef BUFFER_COLUMNS_BLOCK_SIZE
+#define BUFFER_COLUMNS_BLOCK_SIZE (16 * 1024)
+#endif
+
+static bool Columns_Valid(size_t recordSize, const BufferColumn * columns, size_t columnCount, size_t count)
+{
+    if (recordSize == 0 || count > SIZE_MAX / recordSize) {
+        return false;
+    }
+
+    for (size_t i = 0; i < columnCount; i++) {
+        size_t size = columns[i].size;
+
+        if ((size != 1 && size != 2 && size != 4 && size != 8) || columns[i].offset > recordSize
+                || size > recordSize - columns[i].offset) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void Column_Decode(void * dst, const uint8_t * src, size_t recordSize, size_t size, size_t count)
+{
+    size_t i;
+
+    switch (size) {
+    case 1:
+        for (i = 0; i < count; i++) {
+            ((uint8_t *)dst)[i] = src[i * recordSize];
+        }
+        break;
+    case 2:
+        for (i = 0; i < count; i++) {
+            ((uint16_t *)dst)[i] = Serde_BE_BytesToUInt16(src + i * recordSize);
+        }
+        break;
+    case 4:
+        i = Buffer_GetKernels()->gather32(dst, src, recordSize, count);
+        for (; i < count; i++) {
+            ((uint32_t *)dst)[i] = Serde_BE_BytesToUInt32(src + i * recordSize);
+        }
+        break;
+    case 8:
+        i = Buffer_GetKernels()->gather64(dst, src, recordSize, count);
+        for (; i < count; i++) {
+            ((uint64_t *)dst)[i] = Serde_BE_BytesToUInt64(src + i * recordSize);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void Column_Encode(uint8_t * dst, const void * src, size_t recordSize, size_t size, size_t count)
+{
+    size_t i;
+
+    switch (size) {
+    case 1:
+        for (i = 0; i < count; i++) {
+            dst[i * recordSize] = ((const uint8_t *)src)[i];
+        }
+        break;
+    case 2:
+        for (i = 0; i < count; i++) {
+            Serde_BE_UInt16ToBytes(dst + i * recordSize, ((const uint16_t *)src)[i]);
+        }
+        break;
+    case 4:
+        for (i = 0; i < count; i++) {
+            Serde_BE_UInt32ToBytes(dst + i * recordSize, ((const uint32_t *)src)[i]);
+        }
+        break;
+    case 8:
+        for (i = 0; i < count; i++) {
+            Serde_BE_UInt64ToBytes(dst + i * recordSize, ((const uint64_t *)src)[i]);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static size_t Columns_BlockCount(size_t recordSize)
+{
+    size_t records = BUFFER_COLUMNS_BLOCK_SIZE / recordSize;
+
+    return records > 0 ? records : 1;
+}
+
+bool Buffer_WriteColumns(Buffer * buff, size_t recordSize, const BufferColumn * columns, size_t columnCount,
+                         size_t count)
+{
+    size_t blockCount = Columns_BlockCount(recordSize);
+    uint8_t * dst;
+
+    if (!Columns_Valid(recordSize, columns, columnCount, count) || Buffer_WriteAvailable(buff) < count * recordSize) {
+        return false;
+    }
+
+    dst = buff->data + buff->written;
+    memset(dst, 0, count * recordSize);
+
+    for (size_t first = 0; first < count; first += blockCount) {
+        size_t records = count - first < blockCount ? count - first : blockCount;
+
+        for (size_t i = 0; i < columnCount; i++) {
+            const uint8_t * src = (const uint8_t *)columns[i].data + first * columns[i].size;
+
+            Column_Encode(dst + first * recordSize + columns[i].offset, src, recordSize, columns[i].size, records);
+        }
+    }
+
+    buff->written += count * recordSize;
+    return true;
+}
+
+bool Buffer_ReadColumns(ConstBuffer * buff, size_t recordSize, const BufferColumn * columns, size_t columnCount,
+                        size_t count)
+{
+    size_t blockCount = Columns_BlockCount(recordSize);
+    const uint8_t * src;
+
+    if (!Columns_Valid(recordSize, columns, columnCount, count) || Buffer_ReadAvailable(buff) < count * recordSize) {
+        return false;
+    }
+
+    src = buff->data + buff->read;
+
+    for (size_t first = 0; first < count; first += blockCount) {
+        size_t records = count - first < blockCount ? count - first : blockCount;
+
+        for (size_t i = 0; i < columnCount; i++) {
+            uint8_t * dst = (uint8_t *)columns[i].data + first * columns[i].size;
+
+            Column_Decode(dst, src + first * recordSize + columns[i].offset, recordSize, columns[i].size, records);
+        }
+    }
+
+    buff->read += count * recordSize;
+    return true;
+}
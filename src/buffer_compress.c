@@ -0,0 +1,376 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#include "buffer_compress.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "serde.h"
+
+#define MIN_MATCH 4
+/* last match must start at least 12 bytes before the end, last 5 bytes are always literals */
+#define MF_LIMIT 12
+#define LAST_LITERALS 5
+#define MAX_OFFSET 65535
+#define FRAME_HEADER_SIZE 8
+#define FRAME_STORED 0x80000000UL
+
+static uint32_t Lz_Read32(const uint8_t * p)
+{
+    uint32_t val;
+
+    memcpy(&val, p, sizeof(val));
+    return val;
+}
+
+static uint32_t Lz_Hash(uint32_t seq)
+{
+    return (uint32_t)(seq * 2654435761U) >> (32 - BUFFER_COMPRESS_HASH_LOG);
+}
+
+static uint8_t * Lz_WriteLength(uint8_t * op, size_t length)
+{
+    while (length >= 255) {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = (uint8_t)length;
+    return op;
+}
+
+static uint8_t * Lz_WriteSequence(uint8_t * op, const uint8_t * oend, const uint8_t * literals, size_t literalLength,
+                                  size_t offset, size_t matchLength)
+{
+    uint8_t * token = op;
+
+    /* token, length bytes, literals and offset */
+    if ((size_t)(oend - op) < 1 + literalLength / 255 + 1 + literalLength + 2 + matchLength / 255 + 1) {
+        return NULL;
+    }
+
+    op++;
+    if (literalLength >= 15) {
+        *token = 15 << 4;
+        op = Lz_WriteLength(op, literalLength - 15);
+    } else {
+        *token = (uint8_t)(literalLength << 4);
+    }
+    memcpy(op, literals, literalLength);
+    op += literalLength;
+
+    if (offset == 0) {
+        return op;
+    }
+
+    *op++ = (uint8_t)offset;
+    *op++ = (uint8_t)(offset >> 8);
+
+    matchLength -= MIN_MATCH;
+    if (matchLength >= 15) {
+        *token |= 15;
+        op = Lz_WriteLength(op, matchLength - 15);
+    } else {
+        *token |= (uint8_t)matchLength;
+    }
+    return op;
+}
+
+size_t Buffer_CompressBound(size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+bool Buffer_Compress(Buffer * destination, ConstBuffer * source, BufferCompressTable * table)
+{
+    uint32_t * positions = table->positions;
+    const uint8_t * src = source->data + source->read;
+    size_t size = Buffer_ReadAvailable(source);
+    uint8_t * op = destination->data + destination->written;
+    const uint8_t * oend = destination->data + destination->size;
+    size_t ip = 0;
+    size_t anchor = 0;
+    size_t misses = 0;
+
+    if (destination->written > destination->size) {
+        return false;
+    }
+
+    memset(positions, 0, sizeof(table->positions));
+
+    while (size > MF_LIMIT && ip < size - MF_LIMIT) {
+        uint32_t seq = Lz_Read32(src + ip);
+        uint32_t hash = Lz_Hash(seq);
+        size_t candidate = positions[hash];
+
+        positions[hash] = (uint32_t)ip;
+        if (candidate >= ip || ip - candidate > MAX_OFFSET || Lz_Read32(src + candidate) != seq) {
+            /* skip faster through data which do not compress */
+            ip += 1 + (misses++ >> 6);
+            continue;
+        }
+
+        size_t length = MIN_MATCH;
+        while (ip + length < size - LAST_LITERALS && src[candidate + length] == src[ip + length]) {
+            length++;
+        }
+
+        op = Lz_WriteSequence(op, oend, src + anchor, ip - anchor, ip - candidate, length);
+        if (op == NULL) {
+            return false;
+        }
+
+        ip += length;
+        anchor = ip;
+        misses = 0;
+    }
+
+    op = Lz_WriteSequence(op, oend, src + anchor, size - anchor, 0, 0);
+    if (op == NULL) {
+        return false;
+    }
+
+    source->read += size;
+    destination->written = (size_t)(op - destination->data);
+    return true;
+}
+
+static bool Lz_ReadLength(const uint8_t ** ip, const uint8_t * iend, size_t * length)
+{
+    uint8_t byte;
+
+    do {
+        if (*ip >= iend) {
+            return false;
+        }
+        byte = *(*ip)++;
+        *length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+bool Buffer_Decompress(Buffer * destination, ConstBuffer * source, size_t compressedSize)
+{
+    const uint8_t * ip;
+    const uint8_t * iend;
+    uint8_t * op;
+    uint8_t * ostart;
+    const uint8_t * oend;
+
+    if (compressedSize > Buffer_ReadAvailable(source) || destination->written > destination->size) {
+        return false;
+    }
+
+    ip = source->data + source->read;
+    iend = ip + compressedSize;
+    ostart = destination->data + destination->written;
+    op = ostart;
+    oend = destination->data + destination->size;
+
+    while (ip < iend) {
+        uint8_t token = *ip++;
+        size_t literalLength = token >> 4;
+        size_t matchLength = token & 0x0f;
+        size_t offset;
+
+        if (literalLength == 15 && !Lz_ReadLength(&ip, iend, &literalLength)) {
+            return false;
+        }
+        if (literalLength > (size_t)(iend - ip) || literalLength > (size_t)(oend - op)) {
+            return false;
+        }
+        memcpy(op, ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+
+        if (ip == iend) {
+            break;
+        }
+
+        if (iend - ip < 2) {
+            return false;
+        }
+        offset = ip[0] | (size_t)ip[1] << 8;
+        ip += 2;
+
+        if (matchLength == 15 && !Lz_ReadLength(&ip, iend, &matchLength)) {
+            return false;
+        }
+        matchLength += MIN_MATCH;
+
+        if (offset == 0 || offset > (size_t)(op - ostart) || matchLength > (size_t)(oend - op)) {
+            return false;
+        }
+
+        const uint8_t * match = op - offset;
+        if (offset >= matchLength) {
+            memcpy(op, match, matchLength);
+            op += matchLength;
+        } else {
+            /* overlapping match repeats the last offset bytes */
+            while (matchLength-- > 0) {
+                *op++ = *match++;
+            }
+        }
+    }
+
+    source->read += compressedSize;
+    destination->written += (size_t)(op - ostart);
+    return true;
+}
+
+bool CompressedWriter_Init(CompressedWriter * writer, size_t blockSize, BufferFlushHook flush, void * ctx)
+{
+    if (blockSize == 0 || blockSize > FRAME_STORED - 1) {
+        return false;
+    }
+
+    writer->input = Buffer_AllocData(blockSize);
+    writer->output = Buffer_AllocData(FRAME_HEADER_SIZE + Buffer_CompressBound(blockSize));
+    writer->table = malloc(sizeof(*writer->table));
+    writer->flush = flush;
+    writer->ctx = ctx;
+
+    if (writer->input.data == NULL || writer->output.data == NULL || writer->table == NULL) {
+        CompressedWriter_Deinit(writer);
+        return false;
+    }
+    return true;
+}
+
+void CompressedWriter_Deinit(CompressedWriter * writer)
+{
+    Buffer_FreeData(&writer->input);
+    Buffer_FreeData(&writer->output);
+    free(writer->table);
+    writer->table = NULL;
+}
+
+Buffer * CompressedWriter_GetBuffer(CompressedWriter * writer)
+{
+    return &writer->input;
+}
+
+bool CompressedWriter_Flush(CompressedWriter * writer)
+{
+    ConstBuffer input = {
+            .data = writer->input.data,
+            .size = writer->input.written,
+    };
+    Buffer * output = &writer->output;
+    uint32_t compressedSize;
+    bool result;
+
+    if (input.size == 0) {
+        return true;
+    }
+
+    Buffer_Clear(output);
+    output->written = FRAME_HEADER_SIZE;
+    Buffer_Compress(output, &input, writer->table);
+
+    compressedSize = (uint32_t)(output->written - FRAME_HEADER_SIZE);
+    if (compressedSize >= input.size) {
+        /* data do not compress, store them as they are */
+        output->written = FRAME_HEADER_SIZE;
+        Buffer_Write(output, input.data, input.size);
+        compressedSize = (uint32_t)input.size | FRAME_STORED;
+    }
+
+    Serde_BE_UInt32ToBytes(output->data, compressedSize);
+    Serde_BE_UInt32ToBytes(output->data + 4, (uint32_t)input.size);
+
+    ConstBuffer frame = {
+            .data = output->data,
+            .size = output->written,
+    };
+    result = writer->flush(writer->ctx, &frame);
+
+    /* keep the data for retry when the sink fails */
+    if (result) {
+        Buffer_Clear(&writer->input);
+    }
+    return result;
+}
+
+bool CompressedReader_Init(CompressedReader * reader, size_t blockSize, BufferRefillHook refill, void * ctx)
+{
+    if (blockSize == 0 || blockSize > FRAME_STORED - 1) {
+        return false;
+    }
+
+    reader->input = Buffer_AllocData(FRAME_HEADER_SIZE + Buffer_CompressBound(blockSize));
+    reader->output = Buffer_AllocData(blockSize);
+    reader->refill = refill;
+    reader->ctx = ctx;
+
+    if (reader->input.data == NULL || reader->output.data == NULL) {
+        CompressedReader_Deinit(reader);
+        return false;
+    }
+    return true;
+}
+
+void CompressedReader_Deinit(CompressedReader * reader)
+{
+    Buffer_FreeData(&reader->input);
+    Buffer_FreeData(&reader->output);
+}
+
+static bool Reader_Fill(CompressedReader * reader, size_t size)
+{
+    while (reader->input.written < size) {
+        size_t written = reader->input.written;
+
+        if (!reader->refill(reader->ctx, &reader->input) || reader->input.written == written) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ConstBuffer * CompressedReader_Next(CompressedReader * reader)
+{
+    uint32_t compressedSize;
+    uint32_t size;
+    bool stored;
+
+    if (!Reader_Fill(reader, FRAME_HEADER_SIZE)) {
+        return NULL;
+    }
+
+    compressedSize = Serde_BE_BytesToUInt32(reader->input.data);
+    size = Serde_BE_BytesToUInt32(reader->input.data + 4);
+    stored = (compressedSize & FRAME_STORED) != 0;
+    compressedSize &= ~FRAME_STORED;
+
+    if (size > reader->output.size || compressedSize > reader->input.size - FRAME_HEADER_SIZE) {
+        return NULL;
+    }
+    if (!Reader_Fill(reader, FRAME_HEADER_SIZE + compressedSize)) {
+        return NULL;
+    }
+
+    ConstBuffer input = {
+            .data = reader->input.data,
+            .size = FRAME_HEADER_SIZE + compressedSize,
+            .read = FRAME_HEADER_SIZE,
+    };
+
+    Buffer_Clear(&reader->output);
+    if (stored) {
+        if (compressedSize != size || !Buffer_Read(&input, reader->output.data, size)) {
+            return NULL;
+        }
+        reader->output.written = size;
+    } else if (!Buffer_Decompress(&reader->output, &input, compressedSize) || reader->output.written != size) {
+        return NULL;
+    }
+
+    Buffer_MoveBy(&reader->input, FRAME_HEADER_SIZE + compressedSize);
+
+    reader->block.data = reader->output.data;
+    reader->block.size = reader->output.written;
+    reader->block.read = 0;
+    return &reader->block;
+}
@@ -0,0 +1,525 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#include "buffer_cpu.h"
+
+#include <stdatomic.h>
+#include <string.h>
+
+#include "buffer_kernels.h"
+
+/* distance of source prefetch ahead of non-temporal copy */
+#define COPY_PREFETCH 512
+
+/* vector kernels are compiled for their targets regardless of compiler flags */
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define BUFFER_HAVE_X86_KERNELS
+#define TARGET(features) __attribute__((target(features)))
+#endif
+
+static size_t Scalar_Bytes(uint8_t * dst, const uint8_t * src, size_t size)
+{
+    (void)dst;
+    (void)src;
+    (void)size;
+    return 0;
+}
+
+static size_t Scalar_Swap(void * dst, const void * src, size_t count)
+{
+    (void)dst;
+    (void)src;
+    (void)count;
+    return 0;
+}
+
+static size_t Scalar_Gather32(uint32_t * dst, const uint8_t * src, size_t recordSize, size_t count)
+{
+    (void)dst;
+    (void)src;
+    (void)recordSize;
+    (void)count;
+    return 0;
+}
+
+static size_t Scalar_Gather64(uint64_t * dst, const uint8_t * src, size_t recordSize, size_t count)
+{
+    (void)dst;
+    (void)src;
+    (void)recordSize;
+    (void)count;
+    return 0;
+}
+
+static size_t Scalar_PrefixSum64(uint64_t * values, size_t count)
+{
+    (void)values;
+    (void)count;
+    return 0;
+}
+
+static const BufferKernels scalarKernels = {
+    .hexEncode = Scalar_Bytes,
+    .hexDecode = Scalar_Bytes,
+    .base64Encode = Scalar_Bytes,
+    .swap16 = Scalar_Swap,
+    .swap32 = Scalar_Swap,
+    .swap64 = Scalar_Swap,
+    .gather32 = Scalar_Gather32,
+    .gather64 = Scalar_Gather64,
+    .prefixSum64 = Scalar_PrefixSum64,
+    .copyNonTemporal = Scalar_Bytes,
+};
+
+#ifdef BUFFER_HAVE_X86_KERNELS
+TARGET("ssse3") static size_t Hex_EncodeSsse3(uint8_t * dst, const uint8_t * src, size_t size)
+{
+    const __m128i lut = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    size_t i;
+
+    for (i = 0; i + 16 <= size; i += 16) {
+        __m128i in = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(in, 4), mask));
+        __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(in, mask));
+
+        _mm_storeu_si128((__m128i *)(dst + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i *)(dst + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    return i;
+}
+
+TARGET("ssse3") static __m128i Hex_DecodeNibbles(__m128i in, int * valid)
+{
+    const __m128i lower = _mm_or_si128(in, _mm_set1_epi8(0x20));
+    const __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('0' - 1)),
+                                          _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), in));
+    const __m128i isAlpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                          _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower));
+
+    *valid &= _mm_movemask_epi8(_mm_or_si128(isDigit, isAlpha)) == 0xffff;
+    return _mm_or_si128(_mm_and_si128(isDigit, _mm_sub_epi8(in, _mm_set1_epi8('0'))),
+                        _mm_and_si128(isAlpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+}
+
+TARGET("ssse3") static size_t Hex_DecodeSsse3(uint8_t * dst, const uint8_t * src, size_t size)
+{
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    size_t i;
+
+    for (i = 0; i + 32 <= size; i += 32) {
+        int valid = 1;
+        __m128i first = Hex_DecodeNibbles(_mm_loadu_si128((const __m128i *)(src + i)), &valid);
+        __m128i second = Hex_DecodeNibbles(_mm_loadu_si128((const __m128i *)(src + i + 16)), &valid);
+
+        if (!valid) {
+            break;
+        }
+        first = _mm_maddubs_epi16(first, weights);
+        second = _mm_maddubs_epi16(second, weights);
+        _mm_storeu_si128((__m128i *)(dst + i / 2), _mm_packus_epi16(first, second));
+    }
+    return i;
+}
+
+TARGET("ssse3") static size_t Base64_EncodeSsse3(uint8_t * dst, const uint8_t * src, size_t size)
+{
+    const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                          '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                          '/' - 63, 'A', 0, 0);
+    size_t i, o = 0;
+
+    /* 12 bytes are encoded per step but 16 are loaded */
+    for (i = 0; i + 16 <= size; i += 12, o += 16) {
+        __m128i in = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(src + i)), shuffle);
+        __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+        __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+        __m128i indices = _mm_or_si128(t0, t1);
+        __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+
+        reduced = _mm_or_si128(reduced, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+        _mm_storeu_si128((__m128i *)(dst + o), _mm_add_epi8(_mm_shuffle_epi8(offsets, reduced), indices));
+    }
+    return i;
+}
+
+/* byte order reversal within 2, 4 and 8 byte elements of a 16 byte lane */
+#define SWAP16_MASK 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14
+#define SWAP32_MASK 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+#define SWAP64_MASK 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+
+TARGET("ssse3") static size_t Swap_Ssse3(uint8_t * dst, const uint8_t * src, size_t size, __m128i mask)
+{
+    size_t i;
+
+    for (i = 0; i + 16 <= size; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(src + i));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_shuffle_epi8(x, mask));
+    }
+    return i;
+}
+
+TARGET("ssse3") static size_t Swap16_Ssse3(void * dst, const void * src, size_t count)
+{
+    return Swap_Ssse3(dst, src, 2 * count, _mm_setr_epi8(SWAP16_MASK)) / 2;
+}
+
+TARGET("ssse3") static size_t Swap32_Ssse3(void * dst, const void * src, size_t count)
+{
+    return Swap_Ssse3(dst, src, 4 * count, _mm_setr_epi8(SWAP32_MASK)) / 4;
+}
+
+TARGET("ssse3") static size_t Swap64_Ssse3(void * dst, const void * src, size_t count)
+{
+    return Swap_Ssse3(dst, src, 8 * count, _mm_setr_epi8(SWAP64_MASK)) / 8;
+}
+
+TARGET("sse2") static size_t PrefixSum64_Sse2(uint64_t * values, size_t count)
+{
+    __m128i carry = _mm_setzero_si128();
+    size_t i;
+
+    for (i = 0; i + 2 <= count; i += 2) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(values + i));
+
+        x = _mm_add_epi64(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi64(x, carry);
+        _mm_storeu_si128((__m128i *)(values + i), x);
+        carry = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+    return i;
+}
+
+/* streaming stores need aligned destination, unaligned head is copied normally */
+static size_t Copy_Head(uint8_t * dst, const uint8_t * src, size_t size, size_t alignment)
+{
+    size_t head = (alignment - ((uintptr_t)dst & (alignment - 1))) & (alignment - 1);
+
+    if (size < head + 4 * alignment) {
+        return SIZE_MAX;
+    }
+    memcpy(dst, src, head);
+    return head;
+}
+
+TARGET("sse2") static size_t Copy_NonTemporalSse2(uint8_t * dst, const uint8_t * src, size_t size)
+{
+    size_t i = Copy_Head(dst, src, size, 16);
+
+    if (i == SIZE_MAX) {
+        return 0;
+    }
+
+    for (; i + 64 <= size; i += 64) {
+        _mm_prefetch((const char *)(src + i + COPY_PREFETCH), _MM_HINT_NTA);
+        __m128i a = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(src + i + 16));
+        __m128i c = _mm_loadu_si128((const __m128i *)(src + i + 32));
+        __m128i d = _mm_loadu_si128((const __m128i *)(src + i + 48));
+        _mm_stream_si128((__m128i *)(dst + i), a);
+        _mm_stream_si128((__m128i *)(dst + i + 16), b);
+        _mm_stream_si128((__m128i *)(dst + i + 32), c);
+        _mm_stream_si128((__m128i *)(dst + i + 48), d);
+    }
+    _mm_sfence();
+    return i;
+}
+
+TARGET("avx2") static size_t Hex_EncodeAvx2(uint8_t * dst, const uint8_t * src, size_t size)
+{
+    const __m256i lut = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+                                         '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+    size_t i;
+
+    for (i = 0; i + 32 <= size; i += 32) {
+        __m256i in = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(in, 4), mask));
+        __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(in, mask));
+        __m256i first = _mm256_unpacklo_epi8(hi, lo);
+        __m256i second = _mm256_unpackhi_epi8(hi, lo);
+
+        _mm256_storeu_si256((__m256i *)(dst + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256((__m256i *)(dst + 2 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    return i;
+}
+
+TARGET("avx2") static size_t Swap_Avx2(uint8_t * dst, const uint8_t * src, size_t size, __m256i mask)
+{
+    size_t i;
+
+    for (i = 0; i + 32 <= size; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(src + i));
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_shuffle_epi8(x, mask));
+    }
+    return i;
+}
+
+TARGET("avx2") static size_t Swap16_Avx2(void * dst, const void * src, size_t count)
+{
+    return Swap_Avx2(dst, src, 2 * count, _mm256_setr_epi8(SWAP16_MASK, SWAP16_MASK)) / 2;
+}
+
+TARGET("avx2") static size_t Swap32_Avx2(void * dst, const void * src, size_t count)
+{
+    return Swap_Avx2(dst, src, 4 * count, _mm256_setr_epi8(SWAP32_MASK, SWAP32_MASK)) / 4;
+}
+
+TARGET("avx2") static size_t Swap64_Avx2(void * dst, const void * src, size_t count)
+{
+    return Swap_Avx2(dst, src, 8 * count, _mm256_setr_epi8(SWAP64_MASK, SWAP64_MASK)) / 8;
+}
+
+/* gather fields of 8 or 4 records and swap their bytes */
+TARGET("avx2") static size_t Gather32_Avx2(uint32_t * dst, const uint8_t * src, size_t recordSize, size_t count)
+{
+    const __m256i swap = _mm256_setr_epi8(SWAP32_MASK, SWAP32_MASK);
+    const __m256i index = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                             _mm256_set1_epi32((int)recordSize));
+    size_t i = 0;
+
+    if (recordSize > INT32_MAX / 8) {
+        return 0;
+    }
+
+    for (; i + 8 <= count; i += 8) {
+        __m256i x = _mm256_i32gather_epi32((const int *)(src + i * recordSize), index, 1);
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_shuffle_epi8(x, swap));
+    }
+    return i;
+}
+
+TARGET("avx2") static size_t Gather64_Avx2(uint64_t * dst, const uint8_t * src, size_t recordSize, size_t count)
+{
+    const __m256i swap = _mm256_setr_epi8(SWAP64_MASK, SWAP64_MASK);
+    const __m128i index = _mm_mullo_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32((int)recordSize));
+    size_t i = 0;
+
+    if (recordSize > INT32_MAX / 4) {
+        return 0;
+    }
+
+    for (; i + 4 <= count; i += 4) {
+        __m256i x = _mm256_i32gather_epi64((const long long *)(src + i * recordSize), index, 1);
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_shuffle_epi8(x, swap));
+    }
+    return i;
+}
+
+TARGET("avx2") static size_t Copy_NonTemporalAvx2(uint8_t * dst, const uint8_t * src, size_t size)
+{
+    size_t i = Copy_Head(dst, src, size, 32);
+
+    if (i == SIZE_MAX) {
+        return 0;
+    }
+
+    for (; i + 128 <= size; i += 128) {
+        _mm_prefetch((const char *)(src + i + COPY_PREFETCH), _MM_HINT_NTA);
+        _mm_prefetch((const char *)(src + i + COPY_PREFETCH + 64), _MM_HINT_NTA);
+        __m256i a = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(src + i + 32));
+        __m256i c = _mm256_loadu_si256((const __m256i *)(src + i + 64));
+        __m256i d = _mm256_loadu_si256((const __m256i *)(src + i + 96));
+        _mm256_stream_si256((__m256i *)(dst + i), a);
+        _mm256_stream_si256((__m256i *)(dst + i + 32), b);
+        _mm256_stream_si256((__m256i *)(dst + i + 64), c);
+        _mm256_stream_si256((__m256i *)(dst + i + 96), d);
+    }
+    _mm_sfence();
+    return i;
+}
+
+TARGET("avx512f,avx512bw") static size_t Hex_EncodeAvx512(uint8_t * dst, const uint8_t * src, size_t size)
+{
+    const __m512i lut = _mm512_broadcast_i32x4(_mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                                                             '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'));
+    const __m512i mask = _mm512_set1_epi8(0x0f);
+    /* unpack interleaves within 16 byte lanes, put the lanes back in order */
+    const __m512i firstHalf = _mm512_setr_epi64(0, 1, 8, 9, 2, 3, 10, 11);
+    const __m512i secondHalf = _mm512_setr_epi64(4, 5, 12, 13, 6, 7, 14, 15);
+    size_t i;
+
+    for (i = 0; i + 64 <= size; i += 64) {
+        __m512i in = _mm512_loadu_si512((const void *)(src + i));
+        __m512i hi = _mm512_shuffle_epi8(lut, _mm512_and_si512(_mm512_srli_epi16(in, 4), mask));
+        __m512i lo = _mm512_shuffle_epi8(lut, _mm512_and_si512(in, mask));
+        __m512i first = _mm512_unpacklo_epi8(hi, lo);
+        __m512i second = _mm512_unpackhi_epi8(hi, lo);
+
+        _mm512_storeu_si512((void *)(dst + 2 * i), _mm512_permutex2var_epi64(first, firstHalf, second));
+        _mm512_storeu_si512((void *)(dst + 2 * i + 64), _mm512_permutex2var_epi64(first, secondHalf, second));
+    }
+    return i;
+}
+
+TARGET("avx512f,avx512bw") static size_t Swap_Avx512(uint8_t * dst, const uint8_t * src, size_t size, __m128i lane)
+{
+    const __m512i mask = _mm512_broadcast_i32x4(lane);
+    size_t i;
+
+    for (i = 0; i + 64 <= size; i += 64) {
+        __m512i x = _mm512_loadu_si512((const void *)(src + i));
+        _mm512_storeu_si512((void *)(dst + i), _mm512_shuffle_epi8(x, mask));
+    }
+    return i;
+}
+
+TARGET("avx512f,avx512bw") static size_t Swap16_Avx512(void * dst, const void * src, size_t count)
+{
+    return Swap_Avx512(dst, src, 2 * count, _mm_setr_epi8(SWAP16_MASK)) / 2;
+}
+
+TARGET("avx512f,avx512bw") static size_t Swap32_Avx512(void * dst, const void * src, size_t count)
+{
+    return Swap_Avx512(dst, src, 4 * count, _mm_setr_epi8(SWAP32_MASK)) / 4;
+}
+
+TARGET("avx512f,avx512bw") static size_t Swap64_Avx512(void * dst, const void * src, size_t count)
+{
+    return Swap_Avx512(dst, src, 8 * count, _mm_setr_epi8(SWAP64_MASK)) / 8;
+}
+
+TARGET("avx512f") static size_t Copy_NonTemporalAvx512(uint8_t * dst, const uint8_t * src, size_t size)
+{
+    size_t i = Copy_Head(dst, src, size, 64);
+
+    if (i == SIZE_MAX) {
+        return 0;
+    }
+
+    for (; i + 128 <= size; i += 128) {
+        _mm_prefetch((const char *)(src + i + COPY_PREFETCH), _MM_HINT_NTA);
+        _mm_prefetch((const char *)(src + i + COPY_PREFETCH + 64), _MM_HINT_NTA);
+        __m512i a = _mm512_loadu_si512((const void *)(src + i));
+        __m512i b = _mm512_loadu_si512((const void *)(src + i + 64));
+        _mm512_stream_si512((void *)(dst + i), a);
+        _mm512_stream_si512((void *)(dst + i + 64), b);
+    }
+    _mm_sfence();
+    return i;
+}
+
+static const BufferKernels ssse3Kernels = {
+    .hexEncode = Hex_EncodeSsse3,
+    .hexDecode = Hex_DecodeSsse3,
+    .base64Encode = Base64_EncodeSsse3,
+    .swap16 = Swap16_Ssse3,
+    .swap32 = Swap32_Ssse3,
+    .swap64 = Swap64_Ssse3,
+    .gather32 = Scalar_Gather32,
+    .gather64 = Scalar_Gather64,
+    .prefixSum64 = PrefixSum64_Sse2,
+    .copyNonTemporal = Copy_NonTemporalSse2,
+};
+
+static const BufferKernels avx2Kernels = {
+    .hexEncode = Hex_EncodeAvx2,
+    .hexDecode = Hex_DecodeSsse3,
+    .base64Encode = Base64_EncodeSsse3,
+    .swap16 = Swap16_Avx2,
+    .swap32 = Swap32_Avx2,
+    .swap64 = Swap64_Avx2,
+    .gather32 = Gather32_Avx2,
+    .gather64 = Gather64_Avx2,
+    .prefixSum64 = PrefixSum64_Sse2,
+    .copyNonTemporal = Copy_NonTemporalAvx2,
+};
+
+static const BufferKernels avx512Kernels = {
+    .hexEncode = Hex_EncodeAvx512,
+    .hexDecode = Hex_DecodeSsse3,
+    .base64Encode = Base64_EncodeSsse3,
+    .swap16 = Swap16_Avx512,
+    .swap32 = Swap32_Avx512,
+    .swap64 = Swap64_Avx512,
+    .gather32 = Gather32_Avx2,
+    .gather64 = Gather64_Avx2,
+    .prefixSum64 = PrefixSum64_Sse2,
+    .copyNonTemporal = Copy_NonTemporalAvx512,
+};
+#endif
+
+static _Atomic int supportedLevel = -1;
+static _Atomic int usedLevel = -1;
+static _Atomic(const BufferKernels *) usedKernels = NULL;
+
+static BufferCpuLevel Cpu_Detect(void)
+{
+#ifdef BUFFER_HAVE_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return BUFFER_CPU_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return BUFFER_CPU_AVX2;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        return BUFFER_CPU_SSSE3;
+    }
+#endif
+    return BUFFER_CPU_SCALAR;
+}
+
+static BufferCpuLevel Cpu_Supported(void)
+{
+    int level = atomic_load_explicit(&supportedLevel, memory_order_relaxed);
+
+    if (level < 0) {
+        level = Cpu_Detect();
+        atomic_store_explicit(&supportedLevel, level, memory_order_relaxed);
+    }
+    return (BufferCpuLevel)level;
+}
+
+static const BufferKernels * Kernels_ForLevel(BufferCpuLevel level)
+{
+    switch (level) {
+#ifdef BUFFER_HAVE_X86_KERNELS
+    case BUFFER_CPU_AVX512:
+        return &avx512Kernels;
+    case BUFFER_CPU_AVX2:
+        return &avx2Kernels;
+    case BUFFER_CPU_SSSE3:
+        return &ssse3Kernels;
+#endif
+    default:
+        return &scalarKernels;
+    }
+}
+
+BufferCpuLevel BufferCpu_GetLevel(void)
+{
+    int level = atomic_load_explicit(&usedLevel, memory_order_relaxed);
+
+    if (level < 0) {
+        level = Cpu_Supported();
+        atomic_store_explicit(&usedLevel, level, memory_order_relaxed);
+    }
+    return (BufferCpuLevel)level;
+}
+
+BufferCpuLevel BufferCpu_SetLevel(BufferCpuLevel level)
+{
+    if (level > Cpu_Supported()) {
+        level = Cpu_Supported();
+    }
+
+    atomic_store_explicit(&usedLevel, level, memory_order_relaxed);
+    atomic_store_explicit(&usedKernels, Kernels_ForLevel(level), memory_order_relaxed);
+    return level;
+}
+
+const BufferKernels * Buffer_GetKernels(void)
+{
+    const BufferKernels * kernels = atomic_load_explicit(&usedKernels, memory_order_relaxed);
+
+    if (kernels == NULL) {
+        kernels = Kernels_ForLevel(BufferCpu_GetLevel());
+        atomic_store_explicit(&usedKernels, kernels, memory_order_relaxed);
+    }
+    return kernels;
+}
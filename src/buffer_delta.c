@@ -0,0 +1,232 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#include "buffer_delta.h"
+
+#include "bit_buffer.h"
+#include "buffer_kernels.h"
+
+static uint64_t Delta_ZigZag(uint64_t val)
+{
+    return (val << 1) ^ (0 - (val >> 63));
+}
+
+static uint64_t Delta_UnZigZag(uint64_t val)
+{
+    return (val >> 1) ^ (0 - (val & 1));
+}
+
+static bool Delta_WriteVar(Buffer * buff, uint64_t val)
+{
+    size_t written = buff->written;
+
+    Buffer_WriteVarU64(buff, val);
+    return buff->written != written;
+}
+
+static bool Delta_ReadVar(ConstBuffer * buff, uint64_t * val)
+{
+    size_t read = buff->read;
+
+    *val = Buffer_ReadVarU64(buff);
+    return buff->read != read;
+}
+
+static void Delta_PrefixSum(uint64_t * values, size_t count)
+{
+    size_t i = Buffer_GetKernels()->prefixSum64(values, count);
+    uint64_t sum = i > 0 ? values[i - 1] : 0;
+
+    for (; i < count; i++) {
+        sum += values[i];
+        values[i] = sum;
+    }
+}
+
+static void Delta_Write(Buffer * buff, const int64_t * values, size_t count, unsigned order)
+{
+    size_t mark = buff->written;
+    uint64_t previous = 0;
+    uint64_t previousDelta = 0;
+    bool result = Delta_WriteVar(buff, count);
+
+    for (size_t i = 0; i < count && result; i++) {
+        uint64_t delta = (uint64_t)values[i] - previous;
+
+        previous = (uint64_t)values[i];
+        if (order == 2 && i > 0) {
+            uint64_t deltaOfDelta = delta - previousDelta;
+            previousDelta = delta;
+            delta = deltaOfDelta;
+        }
+        result = Delta_WriteVar(buff, Delta_ZigZag(delta));
+    }
+
+    if (!result) {
+        buff->written = mark;
+    }
+}
+
+static bool Delta_Read(ConstBuffer * buff, int64_t * values, size_t maxCount, size_t * count, unsigned order)
+{
+    size_t mark = buff->read;
+    uint64_t * deltas = (uint64_t *)values;
+    uint64_t n;
+
+    if (!Delta_ReadVar(buff, &n) || n > maxCount) {
+        buff->read = mark;
+        return false;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t val;
+
+        if (!Delta_ReadVar(buff, &val)) {
+            buff->read = mark;
+            return false;
+        }
+        deltas[i] = Delta_UnZigZag(val);
+    }
+
+    if (order == 2 && n > 1) {
+        Delta_PrefixSum(deltas + 1, (size_t)n - 1);
+    }
+    Delta_PrefixSum(deltas, (size_t)n);
+    *count = (size_t)n;
+    return true;
+}
+
+void Buffer_WriteDelta(Buffer * buff, const int64_t * values, size_t count)
+{
+    Delta_Write(buff, values, count, 1);
+}
+
+bool Buffer_ReadDelta(ConstBuffer * buff, int64_t * values, size_t maxCount, size_t * count)
+{
+    return Delta_Read(buff, values, maxCount, count, 1);
+}
+
+void Buffer_WriteDeltaOfDelta(Buffer * buff, const int64_t * values, size_t count)
+{
+    Delta_Write(buff, values, count, 2);
+}
+
+bool Buffer_ReadDeltaOfDelta(ConstBuffer * buff, int64_t * values, size_t maxCount, size_t * count)
+{
+    return Delta_Read(buff, values, maxCount, count, 2);
+}
+
+static uint8_t Delta_BitWidth(uint64_t val)
+{
+    uint8_t width = 0;
+
+    while (val != 0) {
+        val >>= 1;
+        width++;
+    }
+    return width;
+}
+
+void Buffer_WriteDeltaPacked(Buffer * buff, const int64_t * values, size_t count)
+{
+    size_t mark = buff->written;
+    int64_t min = 0;
+    uint64_t maxOffset = 0;
+    uint8_t width;
+    size_t packedSize;
+
+    if (count > SIZE_MAX / 64) {
+        return;
+    }
+    if (count == 0) {
+        Delta_WriteVar(buff, 0);
+        return;
+    }
+
+    for (size_t i = 1; i < count; i++) {
+        int64_t delta = (int64_t)((uint64_t)values[i] - (uint64_t)values[i - 1]);
+
+        if (i == 1 || delta < min) {
+            min = delta;
+        }
+    }
+
+    for (size_t i = 1; i < count; i++) {
+        uint64_t offset = (uint64_t)values[i] - (uint64_t)values[i - 1] - (uint64_t)min;
+
+        if (offset > maxOffset) {
+            maxOffset = offset;
+        }
+    }
+
+    width = Delta_BitWidth(maxOffset);
+    packedSize = ((count - 1) * width + 7) / 8;
+
+    if (!Delta_WriteVar(buff, count) || !Delta_WriteVar(buff, Delta_ZigZag((uint64_t)values[0]))
+            || !Delta_WriteVar(buff, Delta_ZigZag((uint64_t)min)) || Buffer_WriteAvailable(buff) < 1 + packedSize) {
+        buff->written = mark;
+        return;
+    }
+    Buffer_WriteU8(buff, width);
+
+    BitBuffer bits = BitBuffer_Init(buff, BIT_ORDER_MSB_FIRST);
+
+    for (size_t i = 1; i < count; i++) {
+        BitBuffer_Write(&bits, (uint64_t)values[i] - (uint64_t)values[i - 1] - (uint64_t)min, width);
+    }
+    BitBuffer_Flush(&bits);
+}
+
+bool Buffer_ReadDeltaPacked(ConstBuffer * buff, int64_t * values, size_t maxCount, size_t * count)
+{
+    size_t mark = buff->read;
+    uint64_t * deltas = (uint64_t *)values;
+    uint64_t n;
+    uint64_t first;
+    uint64_t min;
+    uint8_t width;
+    size_t packedSize;
+
+    if (!Delta_ReadVar(buff, &n) || n > maxCount) {
+        buff->read = mark;
+        return false;
+    }
+    if (n == 0) {
+        *count = 0;
+        return true;
+    }
+
+    if (!Delta_ReadVar(buff, &first) || !Delta_ReadVar(buff, &min) || Buffer_ReadAvailable(buff) < 1) {
+        buff->read = mark;
+        return false;
+    }
+
+    width = Buffer_ReadU8(buff);
+    if (width > 64 || n > SIZE_MAX / 64) {
+        buff->read = mark;
+        return false;
+    }
+    packedSize = ((size_t)(n - 1) * width + 7) / 8;
+    if (Buffer_ReadAvailable(buff) < packedSize) {
+        buff->read = mark;
+        return false;
+    }
+
+    /* bit reader reads ahead by words, keep it inside the packed data */
+    ConstBuffer packed = {
+            .data = buff->data + buff->read,
+            .size = packedSize,
+    };
+    ConstBitBuffer bits = ConstBitBuffer_Init(&packed, BIT_ORDER_MSB_FIRST);
+
+    min = Delta_UnZigZag(min);
+    deltas[0] = Delta_UnZigZag(first);
+    for (size_t i = 1; i < n; i++) {
+        deltas[i] = BitBuffer_Read(&bits, width) + min;
+    }
+    Delta_PrefixSum(deltas, (size_t)n);
+
+    buff->read += packedSize;
+    *count = (size_t)n;
+    return true;
+}
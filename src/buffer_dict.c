@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#include "buffer_dict.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Strings are stored one after another in a single block. Open addressing table with
+ * linear probing keeps the hash next to the id, so most probes of missing strings do not
+ * touch the strings at all.
+ */
+struct _dictEntry {
+    uint32_t offset;
+    uint32_t size;
+};
+
+struct _dictSlot {
+    uint32_t hash;
+    uint32_t id;
+};
+
+struct _bufferDict {
+    size_t maxEntries;
+    size_t maxBytes;
+    size_t count;
+    size_t used;
+    size_t mask;
+    struct _dictEntry * entries;
+    struct _dictSlot * slots;
+    uint8_t * bytes;
+};
+
+static uint32_t Dict_Hash(const uint8_t * data, size_t size)
+{
+    uint32_t hash = 2166136261U;
+
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 16777619U;
+    }
+    return hash;
+}
+
+BufferDict * BufferDict_Create(size_t maxEntries, size_t maxBytes)
+{
+    BufferDict * dict;
+    size_t slots = 1;
+
+    if (maxEntries == 0 || maxEntries >= UINT32_MAX || maxBytes > UINT32_MAX) {
+        return NULL;
+    }
+
+    /* keep the table at most half full */
+    while (slots < 2 * maxEntries) {
+        slots <<= 1;
+    }
+
+    dict = calloc(1, sizeof(*dict));
+    if (dict == NULL) {
+        return NULL;
+    }
+
+    dict->maxEntries = maxEntries;
+    dict->maxBytes = maxBytes;
+    dict->mask = slots - 1;
+    dict->entries = malloc(maxEntries * sizeof(*dict->entries));
+    dict->slots = calloc(slots, sizeof(*dict->slots));
+    dict->bytes = malloc(maxBytes > 0 ? maxBytes : 1);
+
+    if (dict->entries == NULL || dict->slots == NULL || dict->bytes == NULL) {
+        BufferDict_Destroy(dict);
+        return NULL;
+    }
+    return dict;
+}
+
+void BufferDict_Destroy(BufferDict * dict)
+{
+    if (dict == NULL) {
+        return;
+    }
+
+    free(dict->entries);
+    free(dict->slots);
+    free(dict->bytes);
+    free(dict);
+}
+
+void BufferDict_Clear(BufferDict * dict)
+{
+    memset(dict->slots, 0, (dict->mask + 1) * sizeof(*dict->slots));
+    dict->count = 0;
+    dict->used = 0;
+}
+
+size_t BufferDict_Count(BufferDict * dict)
+{
+    return dict->count;
+}
+
+static bool Dict_Fits(BufferDict * dict, size_t size)
+{
+    return dict->count < dict->maxEntries && size <= dict->maxBytes - dict->used;
+}
+
+/* returns id + 1 of the string or zero with slot set to the free slot for it */
+static uint32_t Dict_Find(BufferDict * dict, const uint8_t * data, size_t size, uint32_t hash, size_t * slot)
+{
+    size_t i = hash & dict->mask;
+
+    while (dict->slots[i].id != 0) {
+        const struct _dictSlot * s = &dict->slots[i];
+        const struct _dictEntry * entry = &dict->entries[s->id - 1];
+
+        if (s->hash == hash && entry->size == size && memcmp(dict->bytes + entry->offset, data, size) == 0) {
+            return s->id;
+        }
+        i = (i + 1) & dict->mask;
+    }
+
+    *slot = i;
+    return 0;
+}
+
+static const uint8_t * Dict_Add(BufferDict * dict, const uint8_t * data, size_t size, uint32_t hash, size_t slot)
+{
+    struct _dictEntry * entry = &dict->entries[dict->count];
+
+    entry->offset = (uint32_t)dict->used;
+    entry->size = (uint32_t)size;
+    memcpy(dict->bytes + dict->used, data, size);
+    dict->used += size;
+
+    dict->count++;
+    dict->slots[slot].hash = hash;
+    dict->slots[slot].id = (uint32_t)dict->count;
+    return dict->bytes + entry->offset;
+}
+
+void Buffer_WriteDictStr(Buffer * buff, BufferDict * dict, const char * data, size_t dataSize)
+{
+    const uint8_t * str = (const uint8_t *)data;
+    uint32_t hash = Dict_Hash(str, dataSize);
+    size_t written = buff->written;
+    size_t slot;
+    uint32_t id;
+
+    id = Dict_Find(dict, str, dataSize, hash, &slot);
+    if (id != 0) {
+        Buffer_WriteVarU64(buff, id);
+        return;
+    }
+
+    if (Buffer_WriteAvailable(buff) < 1) {
+        return;
+    }
+    Buffer_WriteU8(buff, 0);
+    Buffer_WriteStrVar(buff, data, dataSize);
+    if (buff->written == written + 1) {
+        buff->written = written;
+        return;
+    }
+
+    if (Dict_Fits(dict, dataSize)) {
+        Dict_Add(dict, str, dataSize, hash, slot);
+    }
+}
+
+bool Buffer_ReadDictStr(ConstBuffer * buff, BufferDict * dict, ConstBuffer * str)
+{
+    size_t mark = buff->read;
+    uint64_t id = Buffer_ReadVarU64(buff);
+    ConstBuffer value;
+
+    if (buff->read == mark) {
+        return false;
+    }
+
+    if (id != 0) {
+        if (id > dict->count) {
+            buff->read = mark;
+            return false;
+        }
+        str->data = dict->bytes + dict->entries[id - 1].offset;
+        str->size = dict->entries[id - 1].size;
+        str->read = 0;
+        return true;
+    }
+
+    if (!Buffer_ReadStrVar(buff, &value)) {
+        buff->read = mark;
+        return false;
+    }
+
+    str->data = value.data + value.read;
+    str->size = value.size - value.read;
+    str->read = 0;
+
+    if (Dict_Fits(dict, str->size)) {
+        uint32_t hash = Dict_Hash(str->data, str->size);
+        size_t slot;
+
+        /* a writer never sends a known string whole, a duplicate would only be unreachable */
+        if (Dict_Find(dict, str->data, str->size, hash, &slot) == 0) {
+            str->data = Dict_Add(dict, str->data, str->size, hash, slot);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#include "buffer_encoding.h"
+
+#include "buffer_kernels.h"
+
+static const char hexDigits[16] = "0123456789abcdef";
+
+static const char base64Digits[64] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static const int8_t base64Values[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
+    -1,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
+    -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
+
+static int Hex_Value(uint8_t c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    c |= 0x20;
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+void Buffer_WriteHex(Buffer * buff, const void * data, size_t dataSize)
+{
+    const uint8_t * src = data;
+    uint8_t * dst;
+    size_t i;
+
+    if (dataSize > SIZE_MAX / 2 || buff->written + 2 * dataSize > buff->size) {
+        return;
+    }
+
+    dst = buff->data + buff->written;
+    for (i = Buffer_GetKernels()->hexEncode(dst, src, dataSize); i < dataSize; i++) {
+        dst[2 * i] = hexDigits[src[i] >> 4];
+        dst[2 * i + 1] = hexDigits[src[i] & 0x0f];
+    }
+    buff->written += 2 * dataSize;
+}
+
+bool Buffer_ReadHex(ConstBuffer * source, Buffer * destination, size_t encodedSize)
+{
+    const uint8_t * src;
+    uint8_t * dst;
+    size_t i;
+
+    if (encodedSize % 2 != 0
+            || source->read + encodedSize > source->size
+            || destination->written + encodedSize / 2 > destination->size) {
+        return false;
+    }
+
+    src = source->data + source->read;
+    dst = destination->data + destination->written;
+    for (i = Buffer_GetKernels()->hexDecode(dst, src, encodedSize); i < encodedSize; i += 2) {
+        int hi = Hex_Value(src[i]);
+        int lo = Hex_Value(src[i + 1]);
+
+        if (hi < 0 || lo < 0) {
+            return false;
+        }
+        dst[i / 2] = (uint8_t)(hi << 4 | lo);
+    }
+
+    source->read += encodedSize;
+    destination->written += encodedSize / 2;
+    return true;
+}
+
+void Buffer_WriteBase64(Buffer * buff, const void * data, size_t dataSize)
+{
+    const uint8_t * src = data;
+    uint8_t * dst;
+    size_t encodedSize = (dataSize + 2) / 3 * 4;
+    size_t i, o;
+
+    if (dataSize > SIZE_MAX / 4 * 3 - 2 || buff->written + encodedSize > buff->size) {
+        return;
+    }
+
+    dst = buff->data + buff->written;
+    i = Buffer_GetKernels()->base64Encode(dst, src, dataSize);
+    o = i / 3 * 4;
+    for (; i + 3 <= dataSize; i += 3, o += 4) {
+        uint32_t triple = (uint32_t)src[i] << 16 | (uint32_t)src[i + 1] << 8 | src[i + 2];
+
+        dst[o] = base64Digits[triple >> 18];
+        dst[o + 1] = base64Digits[(triple >> 12) & 0x3f];
+        dst[o + 2] = base64Digits[(triple >> 6) & 0x3f];
+        dst[o + 3] = base64Digits[triple & 0x3f];
+    }
+
+    if (i < dataSize) {
+        uint32_t triple = (uint32_t)src[i] << 16;
+
+        if (i + 1 < dataSize) {
+            triple |= (uint32_t)src[i + 1] << 8;
+        }
+        dst[o] = base64Digits[triple >> 18];
+        dst[o + 1] = base64Digits[(triple >> 12) & 0x3f];
+        dst[o + 2] = i + 1 < dataSize ? base64Digits[(triple >> 6) & 0x3f] : '=';
+        dst[o + 3] = '=';
+    }
+
+    buff->written += encodedSize;
+}
+
+bool Buffer_ReadBase64(ConstBuffer * source, Buffer * destination, size_t encodedSize)
+{
+    const uint8_t * src;
+    uint8_t * dst;
+    size_t padding = 0;
+    size_t decodedSize;
+    size_t i, o;
+
+    if (encodedSize % 4 != 0 || source->read + encodedSize > source->size) {
+        return false;
+    }
+
+    src = source->data + source->read;
+    if (encodedSize > 0 && src[encodedSize - 1] == '=') {
+        padding = src[encodedSize - 2] == '=' ? 2 : 1;
+    }
+
+    decodedSize = encodedSize / 4 * 3 - padding;
+    if (destination->written + decodedSize > destination->size) {
+        return false;
+    }
+
+    dst = destination->data + destination->written;
+    for (i = 0, o = 0; i < encodedSize; i += 4, o += 3) {
+        int8_t a = base64Values[src[i]];
+        int8_t b = base64Values[src[i + 1]];
+        int8_t c = base64Values[src[i + 2]];
+        int8_t d = base64Values[src[i + 3]];
+        bool last = i + 4 == encodedSize;
+
+        if (last && padding > 0) {
+            d = 0;
+            if (padding == 2) {
+                c = 0;
+            }
+        }
+        if ((a | b | c | d) < 0) {
+            return false;
+        }
+
+        uint32_t triple = (uint32_t)a << 18 | (uint32_t)b << 12 | (uint32_t)c << 6 | (uint32_t)d;
+
+        dst[o] = (uint8_t)(triple >> 16);
+        if (!last || padding < 2) {
+            dst[o + 1] = (uint8_t)(triple >> 8);
+        }
+        if (!last || padding < 1) {
+            dst[o + 2] = (uint8_t)triple;
+        }
+    }
+
+    source->read += encodedSize;
+    destination->written += decodedSize;
+    return true;
+}
@@ -0,0 +1,805 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
+#include "buffer_io.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#ifdef IORING_FEAT_RW_CUR_POS
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#define BUFFER_HAVE_URING
+#endif
+#endif
+#endif
+
+/* attempts to submit requests refused by the kernel before they are cancelled on destroy */
+#define IO_DESTROY_RETRIES 100
+
+enum _ioOp {
+    IO_WRITE,
+    IO_WRITE_CONST,
+    IO_READ,
+};
+
+struct _bufferIoRequest {
+    struct _bufferIoRequest * next;
+    enum _ioOp op;
+    int fd;
+    int64_t offset;
+    void * target;
+    uint8_t * data;
+    size_t size;
+    BufferIoCallback callback;
+    void * ctx;
+    long result;
+};
+
+struct _bufferIoList {
+    struct _bufferIoRequest * head;
+    struct _bufferIoRequest * tail;
+};
+
+#ifdef BUFFER_HAVE_URING
+struct _bufferIoUring {
+    int fd;
+    void * sqRing;
+    size_t sqRingSize;
+    void * cqRing;
+    size_t cqRingSize;
+    struct io_uring_sqe * sqes;
+    size_t sqesSize;
+    unsigned * sqTail;
+    unsigned * sqMask;
+    unsigned * sqArray;
+    unsigned * cqHead;
+    unsigned * cqTail;
+    unsigned * cqMask;
+    struct io_uring_cqe * cqes;
+    struct iovec * fixed;
+    size_t fixedCount;
+};
+#endif
+
+/*
+ * Blocking calls on sockets and pipes wait for the peer, so every request handed to the
+ * workers needs its own worker, otherwise a read waiting for data blocks the write which
+ * would deliver them. Workers are started on demand, up to the queue depth.
+ */
+struct _bufferIoThread {
+    pthread_t * ids;
+    size_t count;
+    size_t max;
+    size_t busy;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    bool stop;
+    struct _bufferIoList pending;
+    struct _bufferIoList completed;
+};
+
+struct _bufferIo {
+    BufferIoBackend backend;
+    struct _bufferIoRequest * requests;
+    struct _bufferIoRequest * free;
+    size_t inFlight;
+    size_t queuedCount;
+    struct _bufferIoList queued;
+#ifdef BUFFER_HAVE_URING
+    struct _bufferIoUring uring;
+#endif
+    struct _bufferIoThread thread;
+};
+
+static void List_Append(struct _bufferIoList * list, struct _bufferIoRequest * req)
+{
+    req->next = NULL;
+    if (list->tail != NULL) {
+        list->tail->next = req;
+    } else {
+        list->head = req;
+    }
+    list->tail = req;
+}
+
+static void List_Splice(struct _bufferIoList * list, struct _bufferIoList * other)
+{
+    if (other->head == NULL) {
+        return;
+    }
+    if (list->tail != NULL) {
+        list->tail->next = other->head;
+    } else {
+        list->head = other->head;
+    }
+    list->tail = other->tail;
+    other->head = NULL;
+    other->tail = NULL;
+}
+
+static void Io_Complete(BufferIo * io, struct _bufferIoRequest * req, long result)
+{
+    BufferIoCallback callback = req->callback;
+    void * ctx = req->ctx;
+
+    if (result > 0) {
+        if (req->op == IO_WRITE_CONST) {
+            ((ConstBuffer *)req->target)->read += (size_t)result;
+        } else if (req->op == IO_READ) {
+            ((Buffer *)req->target)->written += (size_t)result;
+        }
+    }
+
+    req->next = io->free;
+    io->free = req;
+    io->inFlight--;
+
+    if (callback != NULL) {
+        callback(ctx, result);
+    }
+}
+
+static long Io_Transfer(struct _bufferIoRequest * req)
+{
+    ssize_t result;
+
+    do {
+        if (req->op == IO_READ) {
+            result = req->offset < 0 ? read(req->fd, req->data, req->size)
+                                     : pread(req->fd, req->data, req->size, (off_t)req->offset);
+        } else {
+            result = req->offset < 0 ? write(req->fd, req->data, req->size)
+                                     : pwrite(req->fd, req->data, req->size, (off_t)req->offset);
+        }
+    } while (result < 0 && errno == EINTR);
+
+    return result < 0 ? -errno : (long)result;
+}
+
+static void * Thread_Main(void * arg)
+{
+    struct _bufferIoThread * thread = arg;
+    struct _bufferIoRequest * req;
+
+    pthread_mutex_lock(&thread->lock);
+    for (;;) {
+        while (thread->pending.head == NULL && !thread->stop) {
+            pthread_cond_wait(&thread->wake, &thread->lock);
+        }
+        req = thread->pending.head;
+        if (req == NULL) {
+            break;
+        }
+        thread->pending.head = req->next;
+        if (thread->pending.head == NULL) {
+            thread->pending.tail = NULL;
+        }
+        pthread_mutex_unlock(&thread->lock);
+
+        req->result = Io_Transfer(req);
+
+        pthread_mutex_lock(&thread->lock);
+        List_Append(&thread->completed, req);
+        thread->busy--;
+        pthread_cond_signal(&thread->done);
+    }
+    pthread_mutex_unlock(&thread->lock);
+    return NULL;
+}
+
+/* called with the lock held */
+static bool Thread_Start(struct _bufferIoThread * thread)
+{
+    if (pthread_create(&thread->ids[thread->count], NULL, Thread_Main, thread) != 0) {
+        return false;
+    }
+    thread->count++;
+    return true;
+}
+
+static bool Thread_Init(BufferIo * io, unsigned queueDepth)
+{
+    struct _bufferIoThread * thread = &io->thread;
+
+    thread->ids = calloc(queueDepth, sizeof(*thread->ids));
+    if (thread->ids == NULL) {
+        return false;
+    }
+    thread->max = queueDepth;
+
+    pthread_mutex_init(&thread->lock, NULL);
+    pthread_cond_init(&thread->wake, NULL);
+    pthread_cond_init(&thread->done, NULL);
+
+    if (!Thread_Start(thread)) {
+        pthread_cond_destroy(&thread->done);
+        pthread_cond_destroy(&thread->wake);
+        pthread_mutex_destroy(&thread->lock);
+        free(thread->ids);
+        return false;
+    }
+    return true;
+}
+
+static void Thread_Deinit(BufferIo * io)
+{
+    struct _bufferIoThread * thread = &io->thread;
+
+    pthread_mutex_lock(&thread->lock);
+    thread->stop = true;
+    pthread_cond_broadcast(&thread->wake);
+    pthread_mutex_unlock(&thread->lock);
+
+    for (size_t i = 0; i < thread->count; i++) {
+        pthread_join(thread->ids[i], NULL);
+    }
+    pthread_cond_destroy(&thread->done);
+    pthread_cond_destroy(&thread->wake);
+    pthread_mutex_destroy(&thread->lock);
+    free(thread->ids);
+}
+
+static size_t Thread_Flush(BufferIo * io)
+{
+    struct _bufferIoThread * thread = &io->thread;
+    size_t count = io->queuedCount;
+
+    if (count == 0) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&thread->lock);
+    List_Splice(&thread->pending, &io->queued);
+    thread->busy += count;
+    /* workers blocked in calls can not take new requests */
+    while (thread->count < thread->busy && thread->count < thread->max && Thread_Start(thread)) {
+    }
+    if (count > 1) {
+        pthread_cond_broadcast(&thread->wake);
+    } else {
+        pthread_cond_signal(&thread->wake);
+    }
+    pthread_mutex_unlock(&thread->lock);
+
+    io->queuedCount = 0;
+    return count;
+}
+
+static size_t Thread_Poll(BufferIo * io, bool wait)
+{
+    struct _bufferIoList batch;
+    struct _bufferIoRequest * req;
+    size_t count = 0;
+
+    pthread_mutex_lock(&io->thread.lock);
+    while (wait && io->thread.completed.head == NULL) {
+        pthread_cond_wait(&io->thread.done, &io->thread.lock);
+    }
+    batch = io->thread.completed;
+    io->thread.completed.head = NULL;
+    io->thread.completed.tail = NULL;
+    pthread_mutex_unlock(&io->thread.lock);
+
+    while ((req = batch.head) != NULL) {
+        batch.head = req->next;
+        Io_Complete(io, req, req->result);
+        count++;
+    }
+    return count;
+}
+
+#ifdef BUFFER_HAVE_URING
+static int Uring_Setup(unsigned entries, struct io_uring_params * params)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int Uring_Enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return (int)syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, NULL, 0);
+}
+
+static bool Uring_Init(BufferIo * io, unsigned queueDepth)
+{
+    struct _bufferIoUring * uring = &io->uring;
+    struct io_uring_params params;
+    uint8_t * sq;
+    uint8_t * cq;
+
+    memset(&params, 0, sizeof(params));
+    uring->fd = Uring_Setup(queueDepth, &params);
+    if (uring->fd < 0) {
+        return false;
+    }
+
+    /* IORING_OP_READ, IORING_OP_WRITE and offset -1 came with this feature in Linux 5.6 */
+    if ((params.features & IORING_FEAT_RW_CUR_POS) == 0) {
+        close(uring->fd);
+        return false;
+    }
+
+    uring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    uring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (uring->cqRingSize > uring->sqRingSize) {
+            uring->sqRingSize = uring->cqRingSize;
+        }
+        uring->cqRingSize = 0;
+    }
+
+    uring->sqRing = mmap(NULL, uring->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         uring->fd, IORING_OFF_SQ_RING);
+    if (uring->sqRing == MAP_FAILED) {
+        close(uring->fd);
+        return false;
+    }
+
+    uring->cqRing = uring->sqRing;
+    if (uring->cqRingSize > 0) {
+        uring->cqRing = mmap(NULL, uring->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             uring->fd, IORING_OFF_CQ_RING);
+        if (uring->cqRing == MAP_FAILED) {
+            munmap(uring->sqRing, uring->sqRingSize);
+            close(uring->fd);
+            return false;
+        }
+    }
+
+    uring->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    uring->sqes = mmap(NULL, uring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       uring->fd, IORING_OFF_SQES);
+    if (uring->sqes == MAP_FAILED) {
+        if (uring->cqRingSize > 0) {
+            munmap(uring->cqRing, uring->cqRingSize);
+        }
+        munmap(uring->sqRing, uring->sqRingSize);
+        close(uring->fd);
+        return false;
+    }
+
+    sq = uring->sqRing;
+    cq = uring->cqRing;
+    uring->sqTail = (unsigned *)(sq + params.sq_off.tail);
+    uring->sqMask = (unsigned *)(sq + params.sq_off.ring_mask);
+    uring->sqArray = (unsigned *)(sq + params.sq_off.array);
+    uring->cqHead = (unsigned *)(cq + params.cq_off.head);
+    uring->cqTail = (unsigned *)(cq + params.cq_off.tail);
+    uring->cqMask = (unsigned *)(cq + params.cq_off.ring_mask);
+    uring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+    return true;
+}
+
+static void Uring_Deinit(BufferIo * io)
+{
+    struct _bufferIoUring * uring = &io->uring;
+
+    munmap(uring->sqes, uring->sqesSize);
+    if (uring->cqRingSize > 0) {
+        munmap(uring->cqRing, uring->cqRingSize);
+    }
+    munmap(uring->sqRing, uring->sqRingSize);
+    close(uring->fd);
+    free(uring->fixed);
+}
+
+static bool Uring_Register(BufferIo * io, const Buffer * buffs, size_t count)
+{
+    struct _bufferIoUring * uring = &io->uring;
+    struct iovec * fixed;
+
+    if (uring->fixed != NULL || count == 0) {
+        return false;
+    }
+
+    fixed = calloc(count, sizeof(*fixed));
+    if (fixed == NULL) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        fixed[i].iov_base = buffs[i].data;
+        fixed[i].iov_len = buffs[i].size;
+    }
+
+    if (syscall(__NR_io_uring_register, uring->fd, IORING_REGISTER_BUFFERS, fixed, (unsigned)count) < 0) {
+        free(fixed);
+        return false;
+    }
+
+    uring->fixed = fixed;
+    uring->fixedCount = count;
+    return true;
+}
+
+static int Uring_FindFixed(BufferIo * io, const struct _bufferIoRequest * req)
+{
+    struct _bufferIoUring * uring = &io->uring;
+
+    for (size_t i = 0; i < uring->fixedCount; i++) {
+        uint8_t * base = uring->fixed[i].iov_base;
+
+        if (req->data >= base && req->data + req->size <= base + uring->fixed[i].iov_len) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+static void Uring_Queue(BufferIo * io, struct _bufferIoRequest * req)
+{
+    struct _bufferIoUring * uring = &io->uring;
+    unsigned tail = *uring->sqTail;
+    unsigned index = tail & *uring->sqMask;
+    struct io_uring_sqe * sqe = &uring->sqes[index];
+    int fixed = Uring_FindFixed(io, req);
+
+    memset(sqe, 0, sizeof(*sqe));
+    if (req->op == IO_READ) {
+        sqe->opcode = fixed >= 0 ? IORING_OP_READ_FIXED : IORING_OP_READ;
+    } else {
+        sqe->opcode = fixed >= 0 ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+    }
+    if (fixed >= 0) {
+        sqe->buf_index = (uint16_t)fixed;
+    }
+    sqe->fd = req->fd;
+    sqe->off = (uint64_t)req->offset;
+    sqe->addr = (uint64_t)(uintptr_t)req->data;
+    sqe->len = (uint32_t)req->size;
+    sqe->user_data = (uint64_t)(uintptr_t)req;
+
+    uring->sqArray[index] = index;
+    __atomic_store_n(uring->sqTail, tail + 1, __ATOMIC_RELEASE);
+}
+
+static size_t Uring_Poll(BufferIo * io, bool wait);
+
+static size_t Uring_Flush(BufferIo * io)
+{
+    size_t submitted = 0;
+
+    while (io->queuedCount > 0) {
+        int result = Uring_Enter(io->uring.fd, (unsigned)io->queuedCount, 0, 0);
+
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result < 0 && (errno == EAGAIN || errno == EBUSY)) {
+            /* completion queue is full or the kernel is short of memory, make room by reaping */
+            if (Uring_Poll(io, false) > 0) {
+                continue;
+            }
+            break;
+        }
+        if (result <= 0) {
+            /* requests stay queued for the next flush */
+            break;
+        }
+        io->queuedCount -= (size_t)result;
+        submitted += (size_t)result;
+    }
+    return submitted;
+}
+
+/* take back requests which were not accepted by the kernel and complete them with an error */
+static void Uring_Cancel(BufferIo * io)
+{
+    struct _bufferIoUring * uring = &io->uring;
+    unsigned tail = *uring->sqTail;
+    struct _bufferIoList cancelled = {0};
+    struct _bufferIoRequest * req;
+
+    /* queued requests are the last ones in the submission ring */
+    for (unsigned i = (unsigned)io->queuedCount; i > 0; i--) {
+        struct io_uring_sqe * sqe = &uring->sqes[(tail - i) & *uring->sqMask];
+
+        List_Append(&cancelled, (struct _bufferIoRequest *)(uintptr_t)sqe->user_data);
+    }
+    __atomic_store_n(uring->sqTail, tail - (unsigned)io->queuedCount, __ATOMIC_RELEASE);
+    io->queuedCount = 0;
+
+    while ((req = cancelled.head) != NULL) {
+        cancelled.head = req->next;
+        Io_Complete(io, req, -ECANCELED);
+    }
+}
+
+static size_t Uring_Poll(BufferIo * io, bool wait)
+{
+    struct _bufferIoUring * uring = &io->uring;
+    size_t count = 0;
+    unsigned head = *uring->cqHead;
+
+    if (wait && head == __atomic_load_n(uring->cqTail, __ATOMIC_ACQUIRE)) {
+        while (Uring_Enter(uring->fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno == EINTR) {
+        }
+    }
+
+    while (head != __atomic_load_n(uring->cqTail, __ATOMIC_ACQUIRE)) {
+        struct io_uring_cqe * cqe = &uring->cqes[head & *uring->cqMask];
+        struct _bufferIoRequest * req = (struct _bufferIoRequest *)(uintptr_t)cqe->user_data;
+        long result = cqe->res;
+
+        head++;
+        __atomic_store_n(uring->cqHead, head, __ATOMIC_RELEASE);
+
+        Io_Complete(io, req, result);
+        count++;
+    }
+    return count;
+}
+#endif
+
+BufferIo * BufferIo_Create(unsigned queueDepth, BufferIoBackend backend)
+{
+    BufferIo * io;
+
+    if (queueDepth == 0) {
+        return NULL;
+    }
+
+    io = calloc(1, sizeof(*io));
+    if (io == NULL) {
+        return NULL;
+    }
+
+    io->requests = calloc(queueDepth, sizeof(*io->requests));
+    if (io->requests == NULL) {
+        free(io);
+        return NULL;
+    }
+    for (unsigned i = 0; i < queueDepth; i++) {
+        io->requests[i].next = io->free;
+        io->free = &io->requests[i];
+    }
+
+#ifdef BUFFER_HAVE_URING
+    if (backend != BUFFER_IO_THREAD && Uring_Init(io, queueDepth)) {
+        io->backend = BUFFER_IO_URING;
+        return io;
+    }
+#endif
+
+    if (backend != BUFFER_IO_URING && Thread_Init(io, queueDepth)) {
+        io->backend = BUFFER_IO_THREAD;
+        return io;
+    }
+
+    free(io->requests);
+    free(io);
+    return NULL;
+}
+
+void BufferIo_Destroy(BufferIo * io)
+{
+    if (io == NULL) {
+        return;
+    }
+
+    for (unsigned retries = 0; io->inFlight > 0;) {
+        size_t queued = io->queuedCount;
+        size_t inFlight = io->inFlight;
+
+        BufferIo_Poll(io, true);
+        if (io->queuedCount == 0 || io->queuedCount < queued || io->inFlight < inFlight) {
+            retries = 0;
+            continue;
+        }
+        /* only requests refused by the kernel are left, do not retry forever */
+        if (++retries < IO_DESTROY_RETRIES) {
+            usleep(1000);
+            continue;
+        }
+#ifdef BUFFER_HAVE_URING
+        if (io->backend == BUFFER_IO_URING) {
+            Uring_Cancel(io);
+        }
+#endif
+    }
+
+#ifdef BUFFER_HAVE_URING
+    if (io->backend == BUFFER_IO_URING) {
+        Uring_Deinit(io);
+    }
+#endif
+    if (io->backend == BUFFER_IO_THREAD) {
+        Thread_Deinit(io);
+    }
+
+    free(io->requests);
+    free(io);
+}
+
+BufferIoBackend BufferIo_GetBackend(BufferIo * io)
+{
+    return io->backend;
+}
+
+bool BufferIo_RegisterBuffers(BufferIo * io, const Buffer * buffs, size_t count)
+{
+#ifdef BUFFER_HAVE_URING
+    if (io->backend == BUFFER_IO_URING) {
+        return Uring_Register(io, buffs, count);
+    }
+#endif
+    (void)io;
+    (void)buffs;
+    (void)count;
+    return true;
+}
+
+static bool Io_Submit(BufferIo * io, enum _ioOp op, int fd, int64_t offset, void * target, uint8_t * data,
+                      size_t size, BufferIoCallback callback, void * ctx)
+{
+    struct _bufferIoRequest * req = io->free;
+
+    if (req == NULL || size > UINT32_MAX) {
+        return false;
+    }
+    io->free = req->next;
+
+    req->op = op;
+    req->fd = fd;
+    req->offset = offset < 0 ? -1 : offset;
+    req->target = target;
+    req->data = data;
+    req->size = size;
+    req->callback = callback;
+    req->ctx = ctx;
+    req->result = 0;
+
+#ifdef BUFFER_HAVE_URING
+    if (io->backend == BUFFER_IO_URING) {
+        Uring_Queue(io, req);
+    }
+#endif
+    if (io->backend == BUFFER_IO_THREAD) {
+        List_Append(&io->queued, req);
+    }
+
+    io->queuedCount++;
+    io->inFlight++;
+    return true;
+}
+
+bool BufferIo_SubmitWrite(BufferIo * io, int fd, int64_t offset, Buffer * buff, BufferIoCallback callback, void * ctx)
+{
+    return Io_Submit(io, IO_WRITE, fd, offset, buff, buff->data, buff->written, callback, ctx);
+}
+
+bool BufferIo_SubmitWriteConst(BufferIo * io, int fd, int64_t offset, ConstBuffer * buff, BufferIoCallback callback, void * ctx)
+{
+    return Io_Submit(io, IO_WRITE_CONST, fd, offset, buff, (uint8_t *)buff->data + buff->read,
+                     Buffer_ReadAvailable(buff), callback, ctx);
+}
+
+bool BufferIo_SubmitRead(BufferIo * io, int fd, int64_t offset, Buffer * buff, BufferIoCallback callback, void * ctx)
+{
+    return Io_Submit(io, IO_READ, fd, offset, buff, buff->data + buff->written,
+                     Buffer_WriteAvailable(buff), callback, ctx);
+}
+
+size_t BufferIo_Flush(BufferIo * io)
+{
+#ifdef BUFFER_HAVE_URING
+    if (io->backend == BUFFER_IO_URING) {
+        return Uring_Flush(io);
+    }
+#endif
+    return Thread_Flush(io);
+}
+
+size_t BufferIo_Poll(BufferIo * io, bool wait)
+{
+    BufferIo_Flush(io);
+
+    /* nothing to wait for when the kernel did not accept queued requests */
+    wait = wait && io->inFlight > io->queuedCount;
+#ifdef BUFFER_HAVE_URING
+    if (io->backend == BUFFER_IO_URING) {
+        return Uring_Poll(io, wait);
+    }
+#endif
+    return Thread_Poll(io, wait);
+}
+
+size_t BufferIo_InFlight(BufferIo * io)
+{
+    return io->inFlight;
+}
+
+#else
+
+BufferIo * BufferIo_Create(unsigned queueDepth, BufferIoBackend backend)
+{
+    (void)queueDepth;
+    (void)backend;
+    return NULL;
+}
+
+void BufferIo_Destroy(BufferIo * io)
+{
+    (void)io;
+}
+
+BufferIoBackend BufferIo_GetBackend(BufferIo * io)
+{
+    (void)io;
+    return BUFFER_IO_AUTO;
+}
+
+bool BufferIo_RegisterBuffers(BufferIo * io, const Buffer * buffs, size_t count)
+{
+    (void)io;
+    (void)buffs;
+    (void)count;
+    return false;
+}
+
+bool BufferIo_SubmitWrite(BufferIo * io, int fd, int64_t offset, Buffer * buff, BufferIoCallback callback, void * ctx)
+{
+    (void)io;
+    (void)fd;
+    (void)offset;
+    (void)buff;
+    (void)callback;
+    (void)ctx;
+    return false;
+}
+
+bool BufferIo_SubmitWriteConst(BufferIo * io, int fd, int64_t offset, ConstBuffer * buff, BufferIoCallback callback, void * ctx)
+{
+    (void)io;
+    (void)fd;
+    (void)offset;
+    (void)buff;
+    (void)callback;
+    (void)ctx;
+    return false;
+}
+
+bool BufferIo_SubmitRead(BufferIo * io, int fd, int64_t offset, Buffer * buff, BufferIoCallback callback, void * ctx)
+{
+    (void)io;
+    (void)fd;
+    (void)offset;
+    (void)buff;
+    (void)callback;
+    (void)ctx;
+    return false;
+}
+
+size_t BufferIo_Flush(BufferIo * io)
+{
+    (void)io;
+    return 0;
+}
+
+size_t BufferIo_Poll(BufferIo * io, bool wait)
+{
+    (void)io;
+    (void)wait;
+    return 0;
+}
+
+size_t BufferIo_InFlight(BufferIo * io)
+{
+    (void)io;
+    return 0;
+}
+
+#endif
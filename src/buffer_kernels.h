@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#ifndef BUFFER_KERNELS_H
+#define BUFFER_KERNELS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Kernels process whole blocks and return the number of input bytes or values consumed,
+ * the rest is left for the scalar loop of the caller. Scalar kernels consume nothing.
+ */
+
+struct _bufferKernels {
+    size_t (*hexEncode)(uint8_t * dst, const uint8_t * src, size_t size);
+    size_t (*hexDecode)(uint8_t * dst, const uint8_t * src, size_t size);
+    size_t (*base64Encode)(uint8_t * dst, const uint8_t * src, size_t size);
+    /* reverse bytes of count elements, dst may be src */
+    size_t (*swap16)(void * dst, const void * src, size_t count);
+    size_t (*swap32)(void * dst, const void * src, size_t count);
+    size_t (*swap64)(void * dst, const void * src, size_t count);
+    /* load big endian fields of count records */
+    size_t (*gather32)(uint32_t * dst, const uint8_t * src, size_t recordSize, size_t count);
+    size_t (*gather64)(uint64_t * dst, const uint8_t * src, size_t recordSize, size_t count);
+    /* in place inclusive prefix sum, returns the number of summed values */
+    size_t (*prefixSum64)(uint64_t * values, size_t count);
+    /* copy bypassing caches, stores are fenced before return */
+    size_t (*copyNonTemporal)(uint8_t * dst, const uint8_t * src, size_t size);
+};
+typedef struct _bufferKernels BufferKernels;
+
+/**
+ * @brief Get kernels for the CPU
+ *
+ * Kernels are selected on the first call.
+ * @return BufferKernels
+ */
+const BufferKernels * Buffer_GetKernels(void);
+
+#endif /* BUFFER_KERNELS_H */
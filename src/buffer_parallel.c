@@ -0,0 +1,512 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#include "buffer_parallel.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "buffer_kernels.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define BUFFER_HAVE_THREADS
+#endif
+
+#define BUFFER_PARALLEL_MAX_THREADS 64
+
+/* smaller parts are not worth waking up a thread */
+#ifndef BUFFER_PARALLEL_MIN_PART
+#define BUFFER_PARALLEL_MIN_PART (64 * 1024)
+#endif
+
+typedef void (*WorkersTask)(void * ctx, size_t index);
+
+#ifdef BUFFER_HAVE_THREADS
+struct _bufferWorkers {
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    unsigned threads;
+    unsigned started;
+    bool stop;
+    unsigned generation;
+    WorkersTask task;
+    void * ctx;
+    size_t taskCount;
+    size_t nextTask;
+    size_t finished;
+    pthread_t ids[BUFFER_PARALLEL_MAX_THREADS];
+};
+
+static void Workers_Help(BufferWorkers * workers)
+{
+    pthread_mutex_lock(&workers->lock);
+    while (workers->nextTask < workers->taskCount) {
+        size_t index = workers->nextTask++;
+        WorkersTask task = workers->task;
+        void * ctx = workers->ctx;
+
+        pthread_mutex_unlock(&workers->lock);
+        task(ctx, index);
+        pthread_mutex_lock(&workers->lock);
+
+        if (++workers->finished == workers->taskCount) {
+            pthread_cond_signal(&workers->done);
+        }
+    }
+    pthread_mutex_unlock(&workers->lock);
+}
+
+static void * Workers_Main(void * arg)
+{
+    BufferWorkers * workers = arg;
+    unsigned seen = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&workers->lock);
+        while (workers->generation == seen && !workers->stop) {
+            pthread_cond_wait(&workers->start, &workers->lock);
+        }
+        seen = workers->generation;
+        if (workers->stop) {
+            pthread_mutex_unlock(&workers->lock);
+            return NULL;
+        }
+        pthread_mutex_unlock(&workers->lock);
+
+        Workers_Help(workers);
+    }
+}
+
+BufferWorkers * BufferWorkers_Create(unsigned threads)
+{
+    BufferWorkers * workers;
+
+    if (threads == 0 || threads > BUFFER_PARALLEL_MAX_THREADS) {
+        return NULL;
+    }
+
+    workers = calloc(1, sizeof(*workers));
+    if (workers == NULL) {
+        return NULL;
+    }
+
+    pthread_mutex_init(&workers->lock, NULL);
+    pthread_cond_init(&workers->start, NULL);
+    pthread_cond_init(&workers->done, NULL);
+    workers->threads = threads;
+
+    for (unsigned i = 1; i < threads; i++) {
+        if (pthread_create(&workers->ids[workers->started], NULL, Workers_Main, workers) != 0) {
+            BufferWorkers_Destroy(workers);
+            return NULL;
+        }
+        workers->started++;
+    }
+
+    return workers;
+}
+
+void BufferWorkers_Destroy(BufferWorkers * workers)
+{
+    if (workers == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&workers->lock);
+    workers->stop = true;
+    pthread_cond_broadcast(&workers->start);
+    pthread_mutex_unlock(&workers->lock);
+
+    for (unsigned i = 0; i < workers->started; i++) {
+        pthread_join(workers->ids[i], NULL);
+    }
+
+    pthread_cond_destroy(&workers->done);
+    pthread_cond_destroy(&workers->start);
+    pthread_mutex_destroy(&workers->lock);
+    free(workers);
+}
+
+static unsigned Workers_Threads(BufferWorkers * workers)
+{
+    return workers != NULL ? workers->threads : 1;
+}
+
+static void Workers_Run(BufferWorkers * workers, size_t taskCount, WorkersTask task, void * ctx)
+{
+    if (workers == NULL || taskCount == 1) {
+        for (size_t i = 0; i < taskCount; i++) {
+            task(ctx, i);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&workers->lock);
+    workers->task = task;
+    workers->ctx = ctx;
+    workers->taskCount = taskCount;
+    workers->nextTask = 0;
+    workers->finished = 0;
+    workers->generation++;
+    pthread_cond_broadcast(&workers->start);
+    pthread_mutex_unlock(&workers->lock);
+
+    Workers_Help(workers);
+
+    pthread_mutex_lock(&workers->lock);
+    while (workers->finished < workers->taskCount) {
+        pthread_cond_wait(&workers->done, &workers->lock);
+    }
+    pthread_mutex_unlock(&workers->lock);
+}
+#else
+BufferWorkers * BufferWorkers_Create(unsigned threads)
+{
+    (void)threads;
+    return NULL;
+}
+
+void BufferWorkers_Destroy(BufferWorkers * workers)
+{
+    (void)workers;
+}
+
+static unsigned Workers_Threads(BufferWorkers * workers)
+{
+    (void)workers;
+    return 1;
+}
+
+static void Workers_Run(BufferWorkers * workers, size_t taskCount, WorkersTask task, void * ctx)
+{
+    (void)workers;
+    for (size_t i = 0; i < taskCount; i++) {
+        task(ctx, i);
+    }
+}
+#endif
+
+static size_t Parts_Count(BufferWorkers * workers, size_t size)
+{
+    size_t parts = size / BUFFER_PARALLEL_MIN_PART;
+
+    if (parts > Workers_Threads(workers)) {
+        parts = Workers_Threads(workers);
+    }
+    return parts > 0 ? parts : 1;
+}
+
+static size_t Part_Begin(size_t count, size_t parts, size_t index)
+{
+    /* count * index / parts without overflow */
+    return count / parts * index + count % parts * index / parts;
+}
+
+static void Array_Encode(uint8_t * dst, const void * src, size_t count, size_t elemSize)
+{
+    size_t i;
+
+    switch (elemSize) {
+    case 1:
+        memcpy(dst, src, count);
+        break;
+    case 2:
+        for (i = Buffer_GetKernels()->swap16(dst, src, count); i < count; i++) {
+            uint16_t val = ((const uint16_t *)src)[i];
+            dst[2 * i] = (uint8_t)(val >> 8);
+            dst[2 * i + 1] = (uint8_t)val;
+        }
+        break;
+    case 4:
+        for (i = Buffer_GetKernels()->swap32(dst, src, count); i < count; i++) {
+            uint32_t val = ((const uint32_t *)src)[i];
+            dst[4 * i] = (uint8_t)(val >> 24);
+            dst[4 * i + 1] = (uint8_t)(val >> 16);
+            dst[4 * i + 2] = (uint8_t)(val >> 8);
+            dst[4 * i + 3] = (uint8_t)val;
+        }
+        break;
+    case 8:
+        for (i = Buffer_GetKernels()->swap64(dst, src, count); i < count; i++) {
+            uint64_t val = ((const uint64_t *)src)[i];
+            for (size_t b = 0; b < 8; b++) {
+                dst[8 * i + b] = (uint8_t)(val >> (56 - 8 * b));
+            }
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void Array_Decode(void * dst, const uint8_t * src, size_t count, size_t elemSize)
+{
+    size_t i;
+
+    switch (elemSize) {
+    case 1:
+        memcpy(dst, src, count);
+        break;
+    case 2:
+        for (i = Buffer_GetKernels()->swap16(dst, src, count); i < count; i++) {
+            ((uint16_t *)dst)[i] = (uint16_t)(src[2 * i] << 8 | src[2 * i + 1]);
+        }
+        break;
+    case 4:
+        for (i = Buffer_GetKernels()->swap32(dst, src, count); i < count; i++) {
+            ((uint32_t *)dst)[i] = (uint32_t)src[4 * i] << 24 | (uint32_t)src[4 * i + 1] << 16
+                    | (uint32_t)src[4 * i + 2] << 8 | (uint32_t)src[4 * i + 3];
+        }
+        break;
+    case 8:
+        for (i = Buffer_GetKernels()->swap64(dst, src, count); i < count; i++) {
+            uint64_t val = 0;
+            for (size_t b = 0; b < 8; b++) {
+                val = val << 8 | src[8 * i + b];
+            }
+            ((uint64_t *)dst)[i] = val;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static bool Array_ElemSizeValid(size_t elemSize)
+{
+    return elemSize == 1 || elemSize == 2 || elemSize == 4 || elemSize == 8;
+}
+
+void Buffer_WriteArray(Buffer * buff, const void * data, size_t count, size_t elemSize)
+{
+    Buffer_WriteArrayParallel(NULL, buff, data, count, elemSize);
+}
+
+bool Buffer_ReadArray(ConstBuffer * buff, void * data, size_t count, size_t elemSize)
+{
+    return Buffer_ReadArrayParallel(NULL, buff, data, count, elemSize);
+}
+
+struct _arrayJob {
+    uint8_t * bytes;
+    void * values;
+    size_t count;
+    size_t elemSize;
+    size_t parts;
+};
+
+static void Array_EncodeTask(void * ctx, size_t index)
+{
+    struct _arrayJob * job = ctx;
+    size_t begin = Part_Begin(job->count, job->parts, index);
+    size_t end = Part_Begin(job->count, job->parts, index + 1);
+
+    Array_Encode(job->bytes + begin * job->elemSize, (const uint8_t *)job->values + begin * job->elemSize,
+                 end - begin, job->elemSize);
+}
+
+static void Array_DecodeTask(void * ctx, size_t index)
+{
+    struct _arrayJob * job = ctx;
+    size_t begin = Part_Begin(job->count, job->parts, index);
+    size_t end = Part_Begin(job->count, job->parts, index + 1);
+
+    Array_Decode((uint8_t *)job->values + begin * job->elemSize, job->bytes + begin * job->elemSize,
+                 end - begin, job->elemSize);
+}
+
+void Buffer_WriteArrayParallel(BufferWorkers * workers, Buffer * buff, const void * data, size_t count, size_t elemSize)
+{
+    if (!Array_ElemSizeValid(elemSize) || count > Buffer_WriteAvailable(buff) / elemSize) {
+        return;
+    }
+
+    struct _arrayJob job = {
+            .bytes = buff->data + buff->written,
+            .values = (void *)data,
+            .count = count,
+            .elemSize = elemSize,
+            .parts = Parts_Count(workers, count * elemSize),
+    };
+
+    Workers_Run(workers, job.parts, Array_EncodeTask, &job);
+    buff->written += count * elemSize;
+}
+
+bool Buffer_ReadArrayParallel(BufferWorkers * workers, ConstBuffer * buff, void * data, size_t count, size_t elemSize)
+{
+    if (!Array_ElemSizeValid(elemSize) || count > Buffer_ReadAvailable(buff) / elemSize) {
+        return false;
+    }
+
+    struct _arrayJob job = {
+            .bytes = (uint8_t *)buff->data + buff->read,
+            .values = data,
+            .count = count,
+            .elemSize = elemSize,
+            .parts = Parts_Count(workers, count * elemSize),
+    };
+
+    Workers_Run(workers, job.parts, Array_DecodeTask, &job);
+    buff->read += count * elemSize;
+    return true;
+}
+
+static size_t Var_Size(uint64_t val)
+{
+    size_t size = 1;
+
+    while (val >= 0x80) {
+        val >>= 7;
+        size++;
+    }
+    return size;
+}
+
+struct _varJob {
+    uint8_t * bytes;
+    uint64_t * values;
+    size_t count;
+    size_t size;
+    size_t parts;
+    size_t offsets[BUFFER_PARALLEL_MAX_THREADS + 1];
+    size_t firsts[BUFFER_PARALLEL_MAX_THREADS + 1];
+    bool valid[BUFFER_PARALLEL_MAX_THREADS];
+};
+
+static void Var_SizeTask(void * ctx, size_t index)
+{
+    struct _varJob * job = ctx;
+    size_t begin = Part_Begin(job->count, job->parts, index);
+    size_t end = Part_Begin(job->count, job->parts, index + 1);
+    size_t size = 0;
+
+    for (size_t i = begin; i < end; i++) {
+        size += Var_Size(job->values[i]);
+    }
+    job->offsets[index + 1] = size;
+}
+
+static void Var_EncodeTask(void * ctx, size_t index)
+{
+    struct _varJob * job = ctx;
+    size_t begin = Part_Begin(job->count, job->parts, index);
+    size_t end = Part_Begin(job->count, job->parts, index + 1);
+    uint8_t * dst = job->bytes + job->offsets[index];
+
+    for (size_t i = begin; i < end; i++) {
+        uint64_t val = job->values[i];
+
+        while (val >= 0x80) {
+            *dst++ = (uint8_t)val | 0x80;
+            val >>= 7;
+        }
+        *dst++ = (uint8_t)val;
+    }
+}
+
+size_t Buffer_WriteVarArrayParallel(BufferWorkers * workers, Buffer * buff, const uint64_t * data, size_t count)
+{
+    struct _varJob job = {
+            .bytes = buff->data + buff->written,
+            .values = (uint64_t *)data,
+            .count = count,
+            .parts = Parts_Count(workers, count),
+    };
+
+    Workers_Run(workers, job.parts, Var_SizeTask, &job);
+    for (size_t i = 0; i < job.parts; i++) {
+        job.offsets[i + 1] += job.offsets[i];
+    }
+
+    job.size = job.offsets[job.parts];
+    if (job.size > Buffer_WriteAvailable(buff)) {
+        return 0;
+    }
+
+    Workers_Run(workers, job.parts, Var_EncodeTask, &job);
+    buff->written += job.size;
+    return job.size;
+}
+
+static void Var_CountTask(void * ctx, size_t index)
+{
+    struct _varJob * job = ctx;
+    size_t begin = Part_Begin(job->size, job->parts, index);
+    size_t end = Part_Begin(job->size, job->parts, index + 1);
+    size_t count = 0;
+
+    for (size_t i = begin; i < end; i++) {
+        count += (job->bytes[i] & 0x80) == 0;
+    }
+    job->firsts[index + 1] = count;
+}
+
+static void Var_DecodeTask(void * ctx, size_t index)
+{
+    struct _varJob * job = ctx;
+    size_t begin = Part_Begin(job->size, job->parts, index);
+    const uint8_t * src = job->bytes;
+
+    /* values of the part are those whose last byte lies in the part */
+    while (begin > 0 && (src[begin - 1] & 0x80) != 0) {
+        begin--;
+    }
+
+    job->valid[index] = true;
+    for (size_t i = job->firsts[index]; i < job->firsts[index + 1]; i++) {
+        uint64_t val = 0;
+        size_t shift = 0;
+        uint8_t byte;
+
+        do {
+            byte = src[begin++];
+            if (shift >= 64 || (shift == 63 && byte > 1)) {
+                job->valid[index] = false;
+                return;
+            }
+            val |= (uint64_t)(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+
+        job->values[i] = val;
+    }
+}
+
+bool Buffer_ReadVarArrayParallel(BufferWorkers * workers, ConstBuffer * buff, uint64_t * data, size_t count, size_t encodedSize)
+{
+    if (encodedSize > Buffer_ReadAvailable(buff) || encodedSize < count) {
+        return false;
+    }
+    if (encodedSize > 0 && (buff->data[buff->read + encodedSize - 1] & 0x80) != 0) {
+        return false;
+    }
+
+    struct _varJob job = {
+            .bytes = (uint8_t *)buff->data + buff->read,
+            .values = data,
+            .count = count,
+            .size = encodedSize,
+            .parts = Parts_Count(workers, encodedSize),
+    };
+
+    Workers_Run(workers, job.parts, Var_CountTask, &job);
+    for (size_t i = 0; i < job.parts; i++) {
+        job.firsts[i + 1] += job.firsts[i];
+    }
+    if (job.firsts[job.parts] != count) {
+        return false;
+    }
+
+    Workers_Run(workers, job.parts, Var_DecodeTask, &job);
+    for (size_t i = 0; i < job.parts; i++) {
+        if (!job.valid[i]) {
+            return false;
+        }
+    }
+
+    buff->read += encodedSize;
+    return true;
+}
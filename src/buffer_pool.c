@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#include "buffer_pool.h"
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+#define BUFFER_POOL_MAX_CLASSES 32
+
+#ifndef BUFFER_POOL_ATOMIC64
+#define BUFFER_POOL_ATOMIC64 (ATOMIC_LLONG_LOCK_FREE == 2)
+#endif
+
+/*
+ * 32-bit targets would need libatomic or locks for 64-bit atomics, there heads of the stacks
+ * are 32-bit with 16-bit index and tag, and the statistics counters wrap at 32 bits.
+ */
+#if BUFFER_POOL_ATOMIC64
+typedef uint64_t PoolWord;
+#define POOL_INDEX_BITS 32
+#else
+typedef uint32_t PoolWord;
+#define POOL_INDEX_BITS 16
+#endif
+
+#define POOL_INDEX_MASK (((PoolWord)1 << POOL_INDEX_BITS) - 1)
+
+/*
+ * Free lists are stacks of slot indexes (index + 1, zero terminates the list). Head of the stack
+ * carries a tag in its upper half which is incremented on every change, so a head which was
+ * popped and pushed back in the meantime does not pass the compare exchange (ABA problem).
+ */
+struct _bufferPoolClass {
+    size_t size;
+    void ** slots;
+    _Atomic uint32_t * next;
+    _Atomic PoolWord full;
+    _Atomic PoolWord empty;
+};
+
+struct _bufferPool {
+    size_t classCount;
+    size_t slotsPerClass;
+    void * storage;
+    _Atomic PoolWord hits;
+    _Atomic PoolWord misses;
+    _Atomic PoolWord releases;
+    _Atomic PoolWord drops;
+    _Atomic size_t cached;
+    struct _bufferPoolClass classes[BUFFER_POOL_MAX_CLASSES];
+};
+
+static size_t Pool_RoundUp(size_t size)
+{
+    size_t result = 1;
+
+    /* sizes above the largest power of two are clamped to it */
+    while (result < size && result <= SIZE_MAX / 2) {
+        result <<= 1;
+    }
+    return result;
+}
+
+static uint32_t Pool_Pop(_Atomic PoolWord * head, _Atomic uint32_t * next)
+{
+    PoolWord old = atomic_load_explicit(head, memory_order_acquire);
+    PoolWord new;
+    uint32_t index;
+
+    do {
+        index = (uint32_t)(old & POOL_INDEX_MASK);
+        if (index == 0) {
+            return 0;
+        }
+        new = (((old >> POOL_INDEX_BITS) + 1) << POOL_INDEX_BITS) |
+              atomic_load_explicit(&next[index - 1], memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(head, &old, new, memory_order_acq_rel, memory_order_acquire));
+
+    return index;
+}
+
+static void Pool_Push(_Atomic PoolWord * head, _Atomic uint32_t * next, uint32_t index)
+{
+    PoolWord old = atomic_load_explicit(head, memory_order_relaxed);
+    PoolWord new;
+
+    do {
+        atomic_store_explicit(&next[index - 1], (uint32_t)(old & POOL_INDEX_MASK), memory_order_relaxed);
+        new = (((old >> POOL_INDEX_BITS) + 1) << POOL_INDEX_BITS) | index;
+    } while (!atomic_compare_exchange_weak_explicit(head, &old, new, memory_order_release, memory_order_relaxed));
+}
+
+static struct _bufferPoolClass * Pool_FindClass(BufferPool * pool, size_t size)
+{
+    for (size_t i = 0; i < pool->classCount; i++) {
+        if (size <= pool->classes[i].size) {
+            return &pool->classes[i];
+        }
+    }
+    return NULL;
+}
+
+BufferPool * BufferPool_Create(size_t minSize, size_t maxSize, size_t slotsPerClass)
+{
+    BufferPool * pool;
+    size_t classCount = 0;
+    size_t size;
+
+    if (minSize == 0 || slotsPerClass == 0 || slotsPerClass > POOL_INDEX_MASK - 1) {
+        return NULL;
+    }
+
+    minSize = Pool_RoundUp(minSize);
+    maxSize = Pool_RoundUp(maxSize);
+    if (minSize > maxSize) {
+        return NULL;
+    }
+    for (size = minSize; classCount < BUFFER_POOL_MAX_CLASSES; size <<= 1) {
+        classCount++;
+        if (size == maxSize) {
+            break;
+        }
+    }
+    if (slotsPerClass > SIZE_MAX / (sizeof(void *) + sizeof(_Atomic uint32_t)) / classCount) {
+        return NULL;
+    }
+
+    pool = calloc(1, sizeof(*pool));
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    pool->storage = calloc(classCount * slotsPerClass, sizeof(void *) + sizeof(_Atomic uint32_t));
+    if (pool->storage == NULL) {
+        free(pool);
+        return NULL;
+    }
+
+    pool->classCount = classCount;
+    pool->slotsPerClass = slotsPerClass;
+
+    void ** slots = pool->storage;
+    _Atomic uint32_t * next = (_Atomic uint32_t *)(slots + classCount * slotsPerClass);
+
+    for (size_t i = 0; i < classCount; i++) {
+        struct _bufferPoolClass * sizeClass = &pool->classes[i];
+
+        sizeClass->size = minSize << i;
+        sizeClass->slots = slots + i * slotsPerClass;
+        sizeClass->next = next + i * slotsPerClass;
+        atomic_init(&sizeClass->full, 0);
+        atomic_init(&sizeClass->empty, 0);
+
+        for (uint32_t index = 1; index <= slotsPerClass; index++) {
+            Pool_Push(&sizeClass->empty, sizeClass->next, index);
+        }
+    }
+
+    return pool;
+}
+
+void BufferPool_Destroy(BufferPool * pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < pool->classCount; i++) {
+        struct _bufferPoolClass * sizeClass = &pool->classes[i];
+        uint32_t index;
+
+        while ((index = Pool_Pop(&sizeClass->full, sizeClass->next)) != 0) {
+            free(sizeClass->slots[index - 1]);
+        }
+    }
+
+    free(pool->storage);
+    free(pool);
+}
+
+Buffer BufferPool_Acquire(BufferPool * pool, size_t size)
+{
+    struct _bufferPoolClass * sizeClass = Pool_FindClass(pool, size);
+    uint32_t index;
+
+    if (sizeClass == NULL) {
+        atomic_fetch_add_explicit(&pool->misses, 1, memory_order_relaxed);
+        return Buffer_AllocData(size);
+    }
+
+    index = Pool_Pop(&sizeClass->full, sizeClass->next);
+    if (index == 0) {
+        atomic_fetch_add_explicit(&pool->misses, 1, memory_order_relaxed);
+        return Buffer_AllocData(sizeClass->size);
+    }
+
+    Buffer result = {
+            .data = sizeClass->slots[index - 1],
+            .size = sizeClass->size,
+            .alloc = BUFFER_ALLOC_HEAP,
+    };
+
+    Pool_Push(&sizeClass->empty, sizeClass->next, index);
+    atomic_fetch_add_explicit(&pool->hits, 1, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&pool->cached, 1, memory_order_relaxed);
+    return result;
+}
+
+void BufferPool_Release(BufferPool * pool, Buffer * buff)
+{
+    struct _bufferPoolClass * sizeClass;
+    uint32_t index;
+
+    if (buff->data == NULL) {
+        return;
+    }
+
+    sizeClass = Pool_FindClass(pool, buff->size);
+    if (sizeClass == NULL || sizeClass->size != buff->size || buff->alloc != BUFFER_ALLOC_HEAP) {
+        Buffer_FreeData(buff);
+        return;
+    }
+
+    index = Pool_Pop(&sizeClass->empty, sizeClass->next);
+    if (index == 0) {
+        atomic_fetch_add_explicit(&pool->drops, 1, memory_order_relaxed);
+        Buffer_FreeData(buff);
+        return;
+    }
+
+    sizeClass->slots[index - 1] = buff->data;
+    atomic_fetch_add_explicit(&pool->releases, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&pool->cached, 1, memory_order_relaxed);
+    Pool_Push(&sizeClass->full, sizeClass->next, index);
+
+    buff->data = NULL;
+    buff->size = 0;
+    buff->written = 0;
+}
+
+void BufferPool_GetStats(BufferPool * pool, BufferPoolStats * stats)
+{
+    stats->hits = atomic_load_explicit(&pool->hits, memory_order_relaxed);
+    stats->misses = atomic_load_explicit(&pool->misses, memory_order_relaxed);
+    stats->releases = atomic_load_explicit(&pool->releases, memory_order_relaxed);
+    stats->drops = atomic_load_explicit(&pool->drops, memory_order_relaxed);
+    stats->cached = atomic_load_explicit(&pool->cached, memory_order_relaxed);
+}
@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#include "buffer_sizing.h"
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+/* sizes 0 to 3 have their own buckets, then four buckets per power of two */
+#define SIZER_SUB_BITS 2
+#define SIZER_SUB_BUCKETS (1 << SIZER_SUB_BITS)
+#define SIZER_BUCKETS (SIZER_SUB_BUCKETS * 64)
+
+/* counts are halved after this many samples */
+#ifndef BUFFER_SIZER_WINDOW
+#define BUFFER_SIZER_WINDOW 4096
+#endif
+
+/* cached suggestion is recomputed after this many samples */
+#define SIZER_REFRESH 64
+
+struct _bufferSizer {
+    const char * name;
+    size_t minSize;
+    size_t maxSize;
+    double percentile;
+    _Atomic uint32_t samples;
+    _Atomic size_t suggested;
+    _Atomic uint64_t counts[SIZER_BUCKETS];
+};
+
+static unsigned Sizer_Log2(uint64_t val)
+{
+    unsigned result = 0;
+
+    while (val >>= 1) {
+        result++;
+    }
+    return result;
+}
+
+static size_t Sizer_Bucket(uint64_t size)
+{
+    unsigned exponent;
+
+    if (size < SIZER_SUB_BUCKETS) {
+        return (size_t)size;
+    }
+
+    exponent = Sizer_Log2(size);
+    return (exponent - SIZER_SUB_BITS + 1) * SIZER_SUB_BUCKETS
+            + ((size >> (exponent - SIZER_SUB_BITS)) & (SIZER_SUB_BUCKETS - 1));
+}
+
+static uint64_t Sizer_BucketLimit(size_t bucket)
+{
+    size_t exponent;
+    uint64_t sub;
+
+    if (bucket < SIZER_SUB_BUCKETS) {
+        return bucket;
+    }
+
+    exponent = bucket / SIZER_SUB_BUCKETS + SIZER_SUB_BITS - 1;
+    sub = bucket % SIZER_SUB_BUCKETS;
+    /* the last bucket ends at UINT64_MAX */
+    return ((SIZER_SUB_BUCKETS + sub + 1) << (exponent - SIZER_SUB_BITS)) - 1;
+}
+
+BufferSizer * BufferSizer_Create(const char * name, size_t minSize, size_t maxSize, double percentile)
+{
+    BufferSizer * sizer;
+
+    if (minSize > maxSize || !(percentile > 0.0 && percentile <= 100.0)) {
+        return NULL;
+    }
+
+    sizer = calloc(1, sizeof(*sizer));
+    if (sizer == NULL) {
+        return NULL;
+    }
+
+    sizer->name = name;
+    sizer->minSize = minSize;
+    sizer->maxSize = maxSize;
+    sizer->percentile = percentile;
+    atomic_init(&sizer->samples, 0);
+    atomic_init(&sizer->suggested, minSize);
+    for (size_t i = 0; i < SIZER_BUCKETS; i++) {
+        atomic_init(&sizer->counts[i], 0);
+    }
+    return sizer;
+}
+
+void BufferSizer_Destroy(BufferSizer * sizer)
+{
+    free(sizer);
+}
+
+const char * BufferSizer_GetName(BufferSizer * sizer)
+{
+    return sizer->name;
+}
+
+size_t BufferSizer_Percentile(BufferSizer * sizer, double percentile)
+{
+    uint64_t counts[SIZER_BUCKETS];
+    uint64_t total = 0;
+    uint64_t sum = 0;
+    double rank;
+
+    /* counts may change meanwhile, work with a snapshot */
+    for (size_t i = 0; i < SIZER_BUCKETS; i++) {
+        counts[i] = atomic_load_explicit(&sizer->counts[i], memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    rank = (double)total * percentile / 100.0;
+    for (size_t i = 0; i < SIZER_BUCKETS; i++) {
+        sum += counts[i];
+        if (counts[i] > 0 && (double)sum >= rank) {
+            uint64_t limit = Sizer_BucketLimit(i);
+            return limit > SIZE_MAX ? SIZE_MAX : (size_t)limit;
+        }
+    }
+    return SIZE_MAX;
+}
+
+static void Sizer_Refresh(BufferSizer * sizer)
+{
+    size_t size = BufferSizer_Percentile(sizer, sizer->percentile);
+
+    if (size < sizer->minSize) {
+        size = sizer->minSize;
+    }
+    if (size > sizer->maxSize) {
+        size = sizer->maxSize;
+    }
+    atomic_store_explicit(&sizer->suggested, size, memory_order_relaxed);
+}
+
+void BufferSizer_Record(BufferSizer * sizer, size_t size)
+{
+    uint32_t samples;
+
+    atomic_fetch_add_explicit(&sizer->counts[Sizer_Bucket(size)], 1, memory_order_relaxed);
+    samples = atomic_fetch_add_explicit(&sizer->samples, 1, memory_order_relaxed) + 1;
+
+    if (samples % BUFFER_SIZER_WINDOW == 0) {
+        /* only the thread which completed the window ages the counts, concurrent samples may be lost */
+        for (size_t i = 0; i < SIZER_BUCKETS; i++) {
+            uint64_t count = atomic_load_explicit(&sizer->counts[i], memory_order_relaxed);
+            atomic_fetch_sub_explicit(&sizer->counts[i], count / 2, memory_order_relaxed);
+        }
+    }
+    if (samples < SIZER_REFRESH || samples % SIZER_REFRESH == 0) {
+        Sizer_Refresh(sizer);
+    }
+}
+
+size_t BufferSizer_Suggest(BufferSizer * sizer)
+{
+    return atomic_load_explicit(&sizer->suggested, memory_order_relaxed);
+}
+
+Buffer BufferSizer_Alloc(BufferSizer * sizer)
+{
+    return Buffer_AllocData(BufferSizer_Suggest(sizer));
+}
+
+void BufferSizer_Free(BufferSizer * sizer, Buffer * buff)
+{
+    BufferSizer_Record(sizer, buff->written);
+    Buffer_FreeData(buff);
+}
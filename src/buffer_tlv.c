@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#include "buffer_tlv.h"
+
+#include <string.h>
+
+#include "serde.h"
+
+#define TLV_HEADER_SIZE 3
+
+void Buffer_WriteTlv(Buffer * buff, uint8_t tag, const void * data, size_t dataSize)
+{
+    if (dataSize > UINT16_MAX || TLV_HEADER_SIZE + dataSize > Buffer_WriteAvailable(buff)) {
+        return;
+    }
+
+    Buffer_WriteU8(buff, tag);
+    Buffer_WriteU16(buff, (uint16_t)dataSize);
+    Buffer_Write(buff, data, dataSize);
+}
+
+bool Buffer_ReadTlv(ConstBuffer * buff, uint8_t * tag, ConstBuffer * value)
+{
+    const uint8_t * header = buff->data + buff->read;
+    size_t size;
+
+    if (Buffer_ReadAvailable(buff) < TLV_HEADER_SIZE) {
+        return false;
+    }
+
+    size = Serde_BE_BytesToUInt16(header + 1);
+    if (Buffer_ReadAvailable(buff) - TLV_HEADER_SIZE < size) {
+        return false;
+    }
+
+    *tag = header[0];
+    value->data = header + TLV_HEADER_SIZE;
+    value->size = size;
+    value->read = 0;
+    buff->read += TLV_HEADER_SIZE + size;
+    return true;
+}
+
+bool TlvIndex_Build(TlvIndex * index, const ConstBuffer * record)
+{
+    size_t offset = record->read;
+
+    memset(index, 0, sizeof(*index));
+
+    if (record->size >= UINT32_MAX) {
+        return false;
+    }
+
+    while (offset < record->size) {
+        const uint8_t * header = record->data + offset;
+
+        if (record->size - offset < TLV_HEADER_SIZE) {
+            return false;
+        }
+        if (index->offsets[header[0]] == 0) {
+            index->offsets[header[0]] = (uint32_t)offset + 1;
+        }
+        offset += TLV_HEADER_SIZE + Serde_BE_BytesToUInt16(header + 1);
+    }
+
+    return offset == record->size;
+}
+
+bool TlvIndex_Get(const TlvIndex * index, const ConstBuffer * record, uint8_t tag, ConstBuffer * value)
+{
+    uint32_t offset = index->offsets[tag];
+
+    if (offset == 0) {
+        return false;
+    }
+
+    const uint8_t * header = record->data + offset - 1;
+
+    value->data = header + TLV_HEADER_SIZE;
+    value->size = Serde_BE_BytesToUInt16(header + 1);
+    value->read = 0;
+    return true;
+}
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#include "shared_buffer.h"
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+struct _sharedBuffer {
+    _Atomic size_t refs;
+    Buffer buff;
+    uint8_t data[];
+};
+
+SharedBuffer * SharedBuffer_Alloc(size_t size)
+{
+    SharedBuffer * shared;
+
+    if (size > SIZE_MAX - sizeof(*shared)) {
+        return NULL;
+    }
+
+    shared = malloc(sizeof(*shared) + size);
+    if (shared == NULL) {
+        return NULL;
+    }
+
+    atomic_init(&shared->refs, 1);
+    shared->buff.data = shared->data;
+    shared->buff.size = size;
+    shared->buff.written = 0;
+    /* data live in the same allocation as the header, they can not grow nor be freed alone */
+    shared->buff.alloc = BUFFER_ALLOC_NONE;
+    return shared;
+}
+
+Buffer * SharedBuffer_GetBuffer(SharedBuffer * shared)
+{
+    return &shared->buff;
+}
+
+SharedConstBuffer SharedBuffer_Share(SharedBuffer * shared)
+{
+    SharedConstBuffer result = {
+            .buff = {
+                    .data = shared->buff.data,
+                    .size = shared->buff.written,
+            },
+            .owner = shared,
+    };
+
+    atomic_fetch_add_explicit(&shared->refs, 1, memory_order_relaxed);
+    return result;
+}
+
+void SharedBuffer_Release(SharedBuffer * shared)
+{
+    if (shared == NULL) {
+        return;
+    }
+
+    if (atomic_fetch_sub_explicit(&shared->refs, 1, memory_order_acq_rel) == 1) {
+        free(shared);
+    }
+}
+
+SharedConstBuffer SharedConstBuffer_Copy(const SharedConstBuffer * handle)
+{
+    SharedConstBuffer result = {
+            .buff = {
+                    .data = handle->buff.data,
+                    .size = handle->buff.size,
+            },
+            .owner = handle->owner,
+    };
+
+    if (handle->owner != NULL) {
+        atomic_fetch_add_explicit(&handle->owner->refs, 1, memory_order_relaxed);
+    }
+    return result;
+}
+
+void SharedConstBuffer_Release(SharedConstBuffer * handle)
+{
+    SharedBuffer_Release(handle->owner);
+    handle->owner = NULL;
+    handle->buff.data = NULL;
+    handle->buff.size = 0;
+    handle->buff.read = 0;
+}
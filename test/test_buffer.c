@@ -4,8 +4,29 @@
 #include "unity.h"
 
 #include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#endif
 
 #include "buffer.h"
+#include "buffer_pool.h"
+#include "buffer_encoding.h"
+#include "bit_buffer.h"
+#include "shared_buffer.h"
+#include "buffer_parallel.h"
+#include "buffer_io.h"
+#include "buffer_compress.h"
+#include "buffer_tlv.h"
+#include "buffer_delta.h"
+#include "buffer_columns.h"
+#include "buffer_cpu.h"
+#include "buffer_dict.h"
+#include "buffer_sizing.h"
 
 void test_Buffer_AllocData_FreeData(void)
 {
@@ -20,6 +41,132 @@ void test_Buffer_AllocData_FreeData(void)
     TEST_ASSERT_EQUAL(0, buffer.size);
 }
 
+void test_Buffer_AllocDataEx(void)
+{
+    BufferAllocOptions options = {
+            .alignment = 64,
+    };
+    Buffer buffer;
+
+    buffer = Buffer_AllocDataEx(100, &options);
+    TEST_ASSERT_NOT_NULL(buffer.data);
+    TEST_ASSERT_EQUAL(100, buffer.size);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)buffer.data % 64);
+    Buffer_WriteU64(&buffer, 1);
+    Buffer_FreeData(&buffer);
+    TEST_ASSERT_NULL(buffer.data);
+    TEST_ASSERT_EQUAL(0, buffer.size);
+
+    options.alignment = 4096;
+    options.prefault = true;
+    buffer = Buffer_AllocDataEx(10000, &options);
+    TEST_ASSERT_NOT_NULL(buffer.data);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)buffer.data % 4096);
+    Buffer_FreeData(&buffer);
+
+    options.alignment = 3;
+    buffer = Buffer_AllocDataEx(100, &options);
+    TEST_ASSERT_NULL(buffer.data);
+}
+
+void test_Buffer_AllocDataEx_HugePages(void)
+{
+    BufferAllocOptions options = {
+            .alignment = 64,
+            .hugePages = true,
+    };
+    Buffer buffer;
+
+    buffer = Buffer_AllocDataEx(3 * 1024 * 1024, &options);
+    TEST_ASSERT_NOT_NULL(buffer.data);
+    TEST_ASSERT_GREATER_OR_EQUAL(3 * 1024 * 1024, buffer.size);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)buffer.data % 64);
+#if defined(__unix__) || defined(__APPLE__)
+    TEST_ASSERT_EQUAL(0, (uintptr_t)buffer.data % (2 * 1024 * 1024));
+#endif
+
+    buffer.data[buffer.size - 1] = 0xAA;
+    Buffer_FreeData(&buffer);
+    TEST_ASSERT_NULL(buffer.data);
+    TEST_ASSERT_EQUAL(0, buffer.size);
+}
+
+void test_Buffer_Inline(void)
+{
+    BUFFER_INLINE(buffer, 4);
+
+    TEST_ASSERT_EQUAL(4, buffer.size);
+    TEST_ASSERT_EQUAL_PTR(buffer_storage, buffer.data);
+
+    Buffer_WriteU32(&buffer, 0x11223344UL);
+    TEST_ASSERT_EQUAL(0, Buffer_WriteAvailable(&buffer));
+    TEST_ASSERT_EQUAL(0x44, buffer_storage[3]);
+
+    Buffer_FreeData(&buffer);
+    TEST_ASSERT_NULL(buffer.data);
+}
+
+void test_Buffer_HandBuilt(void)
+{
+    Buffer buffer = {
+            .data = malloc(4),
+            .size = 4,
+    };
+
+    /* zero alloc means malloc'd data, they grow and are freed */
+    TEST_ASSERT_EQUAL(BUFFER_ALLOC_HEAP, buffer.alloc);
+    TEST_ASSERT_TRUE(Buffer_Reserve(&buffer, 8));
+    TEST_ASSERT_EQUAL(8, buffer.size);
+
+    Buffer_FreeData(&buffer);
+    TEST_ASSERT_NULL(buffer.data);
+}
+
+void test_Buffer_NotOwned(void)
+{
+    uint8_t data[4];
+    Buffer buffer = {
+            .data = data,
+            .size = sizeof(data),
+            .alloc = BUFFER_ALLOC_NONE,
+    };
+
+    TEST_ASSERT_TRUE(Buffer_Reserve(&buffer, 4));
+    TEST_ASSERT_FALSE(Buffer_Reserve(&buffer, 5));
+    TEST_ASSERT_EQUAL_PTR(data, buffer.data);
+
+    Buffer_FreeData(&buffer);
+    TEST_ASSERT_NULL(buffer.data);
+    TEST_ASSERT_EQUAL(0, buffer.size);
+}
+
+void test_Buffer_Small_Reserve(void)
+{
+    BUFFER_SMALL(4) small;
+
+    BUFFER_SMALL_INIT(&small);
+    TEST_ASSERT_EQUAL(4, small.buff.size);
+
+    TEST_ASSERT_TRUE(Buffer_Reserve(&small.buff, 2));
+    Buffer_WriteU16(&small.buff, 0x1122);
+    TEST_ASSERT_EQUAL_PTR(small.storage, small.buff.data);
+
+    TEST_ASSERT_TRUE(Buffer_Reserve(&small.buff, 6));
+    TEST_ASSERT_TRUE(small.buff.data != small.storage);
+    TEST_ASSERT_EQUAL(BUFFER_ALLOC_HEAP, small.buff.alloc);
+    TEST_ASSERT_EQUAL(8, small.buff.size);
+    TEST_ASSERT_EQUAL(2, small.buff.written);
+    TEST_ASSERT_EQUAL(0x11, small.buff.data[0]);
+
+    Buffer_WriteU32(&small.buff, 0x33445566UL);
+    TEST_ASSERT_TRUE(Buffer_Reserve(&small.buff, 100));
+    TEST_ASSERT_EQUAL(106, small.buff.size);
+    TEST_ASSERT_EQUAL(0x66, small.buff.data[5]);
+
+    Buffer_FreeData(&small.buff);
+    TEST_ASSERT_NULL(small.buff.data);
+}
+
 void test_Buffer_WriteAvailable(void)
 {
     Buffer buffer;
@@ -241,6 +388,37 @@ void test_Buffer_WriteS8(void)
     TEST_ASSERT_EQUAL(0, Buffer_WriteAvailable(&buffer));
 }
 
+void test_Buffer_WriteVarU64(void)
+{
+    uint8_t data[12];
+
+    memset(data, 0, sizeof(data));
+
+    Buffer buffer = {
+            .data = data,
+            .size = sizeof(data),
+    };
+
+    Buffer_WriteVarU64(&buffer, 1);
+    TEST_ASSERT_EQUAL(1, buffer.written);
+    TEST_ASSERT_EQUAL(0x01, data[0]);
+
+    Buffer_WriteVarU64(&buffer, 300);
+    TEST_ASSERT_EQUAL(3, buffer.written);
+    TEST_ASSERT_EQUAL(0xac, data[1]);
+    TEST_ASSERT_EQUAL(0x02, data[2]);
+
+    Buffer_WriteVarU64(&buffer, UINT64_MAX);
+    TEST_ASSERT_EQUAL(3, buffer.written);
+    TEST_ASSERT_EQUAL(0x00, data[3]);
+
+    Buffer_Clear(&buffer);
+    Buffer_WriteVarU64(&buffer, UINT64_MAX);
+    TEST_ASSERT_EQUAL(10, buffer.written);
+    TEST_ASSERT_EQUAL(0xff, data[8]);
+    TEST_ASSERT_EQUAL(0x01, data[9]);
+}
+
 void test_Buffer_WriteStr(void)
 {
     uint8_t data[] = {1, 2, 3, 4, 5};
@@ -269,6 +447,42 @@ void test_Buffer_WriteStr(void)
 
 }
 
+void test_Buffer_WriteStrPrefixed(void)
+{
+    uint8_t data[12];
+
+    memset(data, 0, sizeof(data));
+
+    Buffer buffer = {
+            .data = data,
+            .size = sizeof(data),
+    };
+
+    Buffer_WriteStr8(&buffer, "ab", 2);
+    TEST_ASSERT_EQUAL(3, buffer.written);
+    TEST_ASSERT_EQUAL(2, data[0]);
+    TEST_ASSERT_EQUAL_CHAR_ARRAY("ab", data + 1, 2);
+
+    Buffer_WriteStr16(&buffer, "cde", 3);
+    TEST_ASSERT_EQUAL(8, buffer.written);
+    TEST_ASSERT_EQUAL(0, data[3]);
+    TEST_ASSERT_EQUAL(3, data[4]);
+    TEST_ASSERT_EQUAL_CHAR_ARRAY("cde", data + 5, 3);
+
+    Buffer_WriteStrVar(&buffer, "fghi", 4);
+    TEST_ASSERT_EQUAL(8, buffer.written);
+    TEST_ASSERT_EQUAL(0, data[8]);
+
+    Buffer_WriteStrVar(&buffer, "fgh", 3);
+    TEST_ASSERT_EQUAL(12, buffer.written);
+    TEST_ASSERT_EQUAL(3, data[8]);
+    TEST_ASSERT_EQUAL_CHAR_ARRAY("fgh", data + 9, 3);
+
+    Buffer_Clear(&buffer);
+    Buffer_WriteStr8(&buffer, (const char *)data, 256);
+    TEST_ASSERT_EQUAL(0, buffer.written);
+}
+
 void test_Buffer_Write(void)
 {
     Buffer buffer;
@@ -348,6 +562,51 @@ void test_Buffer_ReadAvailable(void)
     TEST_ASSERT_EQUAL(5, Buffer_ReadAvailable(&buffer));
 }
 
+void test_ConstBuffer_MarkRewind(void)
+{
+    const char data[] = "abcdefgh";
+    ConstBuffer buffer = {
+            .sdata = data,
+            .size = 7,
+    };
+    size_t mark;
+
+    Buffer_ReadU8(&buffer);
+    mark = ConstBuffer_Mark(&buffer);
+    TEST_ASSERT_EQUAL(1, mark);
+
+    TEST_ASSERT_EQUAL_UINT32(0x62636465, Buffer_ReadU32(&buffer));
+    TEST_ASSERT_EQUAL_UINT32(0, Buffer_ReadU32(&buffer));
+    ConstBuffer_Rewind(&buffer, mark);
+    TEST_ASSERT_EQUAL(6, Buffer_ReadAvailable(&buffer));
+
+    TEST_ASSERT_EQUAL_UINT16(0x6263, Buffer_ReadU16(&buffer));
+    ConstBuffer_Rewind(&buffer, 5);
+    TEST_ASSERT_EQUAL(3, buffer.read);
+}
+
+void test_Buffer_Peek(void)
+{
+    const char data[] = "abcdefgh";
+    ConstBuffer buffer = {
+            .sdata = data,
+            .size = 8,
+    };
+
+    TEST_ASSERT_EQUAL_UINT64(0x6162636465666768ULL, Buffer_PeekU64(&buffer));
+    TEST_ASSERT_EQUAL_UINT32(0x61626364, Buffer_PeekU32(&buffer));
+    TEST_ASSERT_EQUAL_UINT16(0x6162, Buffer_PeekU16(&buffer));
+    TEST_ASSERT_EQUAL_UINT8(0x61, Buffer_PeekU8(&buffer));
+    TEST_ASSERT_EQUAL(8, Buffer_ReadAvailable(&buffer));
+
+    Buffer_ReadU32(&buffer);
+    Buffer_ReadU16(&buffer);
+    TEST_ASSERT_EQUAL_UINT64(0, Buffer_PeekU64(&buffer));
+    TEST_ASSERT_EQUAL_UINT32(0, Buffer_PeekU32(&buffer));
+    TEST_ASSERT_EQUAL_UINT16(0x6768, Buffer_PeekU16(&buffer));
+    TEST_ASSERT_EQUAL(2, Buffer_ReadAvailable(&buffer));
+}
+
 void test_Buffer_ReadU64(void)
 {
     const char data[] = "abcdefgh01234567";
@@ -492,6 +751,79 @@ void test_Buffer_ReadS8(void)
     TEST_ASSERT_EQUAL(0, Buffer_ReadAvailable(&buffer));
 }
 
+void test_Buffer_ReadVarU64(void)
+{
+    const uint8_t data[] = {0x01, 0xac, 0x02, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x80};
+    ConstBuffer buffer = {
+            .data = data,
+            .size = sizeof(data),
+    };
+
+    TEST_ASSERT_EQUAL_UINT64(1, Buffer_ReadVarU64(&buffer));
+    TEST_ASSERT_EQUAL_UINT64(300, Buffer_ReadVarU64(&buffer));
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, Buffer_ReadVarU64(&buffer));
+    TEST_ASSERT_EQUAL(1, Buffer_ReadAvailable(&buffer));
+
+    TEST_ASSERT_EQUAL_UINT64(0, Buffer_ReadVarU64(&buffer));
+    TEST_ASSERT_EQUAL(1, Buffer_ReadAvailable(&buffer));
+}
+
+void test_Buffer_ReadVarU64_Overflow(void)
+{
+    const uint8_t data[] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02};
+    const uint8_t continued[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x81, 0x00};
+    ConstBuffer buffer = {
+            .data = data,
+            .size = sizeof(data),
+    };
+
+    TEST_ASSERT_EQUAL_UINT64(0, Buffer_ReadVarU64(&buffer));
+    TEST_ASSERT_EQUAL(0, buffer.read);
+
+    buffer.data = continued;
+    buffer.size = sizeof(continued);
+    TEST_ASSERT_EQUAL_UINT64(0, Buffer_ReadVarU64(&buffer));
+    TEST_ASSERT_EQUAL(0, buffer.read);
+
+    BufferWorkers * workers = BufferWorkers_Create(2);
+    uint64_t value;
+
+    buffer.data = data;
+    buffer.size = sizeof(data);
+    TEST_ASSERT_FALSE(Buffer_ReadVarArrayParallel(workers, &buffer, &value, 1, sizeof(data)));
+    TEST_ASSERT_EQUAL(0, buffer.read);
+    BufferWorkers_Destroy(workers);
+}
+
+void test_Buffer_ReadStrPrefixed(void)
+{
+    const char data[] = "\x02" "ab" "\x00\x03" "cde" "\x03" "fgh" "\x05" "ij";
+    ConstBuffer buffer = {
+            .sdata = data,
+            .size = sizeof(data) - 1,
+    };
+    ConstBuffer str;
+
+    TEST_ASSERT_TRUE(Buffer_ReadStr8(&buffer, &str));
+    TEST_ASSERT_EQUAL(2, str.size);
+    TEST_ASSERT_EQUAL_PTR(data + 1, str.sdata);
+
+    TEST_ASSERT_TRUE(Buffer_ReadStr16(&buffer, &str));
+    TEST_ASSERT_EQUAL(3, str.size);
+    TEST_ASSERT_EQUAL_CHAR_ARRAY("cde", str.sdata, 3);
+
+    TEST_ASSERT_TRUE(Buffer_ReadStrVar(&buffer, &str));
+    TEST_ASSERT_EQUAL(3, Buffer_ReadAvailable(&str));
+    TEST_ASSERT_EQUAL_CHAR_ARRAY("fgh", str.sdata, 3);
+
+    TEST_ASSERT_FALSE(Buffer_ReadStrVar(&buffer, &str));
+    TEST_ASSERT_EQUAL(3, Buffer_ReadAvailable(&buffer));
+
+    buffer.read = buffer.size;
+    TEST_ASSERT_FALSE(Buffer_ReadStr8(&buffer, &str));
+    TEST_ASSERT_EQUAL(buffer.size, buffer.read);
+}
+
 void test_Buffer_Read(void)
 {
     const char data[] = "abcd";
@@ -534,6 +866,1241 @@ void test_Buffer_Format(void)
     TEST_ASSERT_EQUAL(0, buffer.sdata[11]);
 }
 
+void test_BufferPool_AcquireRelease(void)
+{
+    BufferPool * pool = BufferPool_Create(60, 256, 2);
+    BufferPoolStats stats;
+    Buffer buffer;
+    uint8_t * data;
+
+    TEST_ASSERT_NOT_NULL(pool);
+
+    buffer = BufferPool_Acquire(pool, 100);
+    TEST_ASSERT_NOT_NULL(buffer.data);
+    TEST_ASSERT_EQUAL(128, buffer.size);
+    TEST_ASSERT_EQUAL(0, buffer.written);
+    data = buffer.data;
+
+    Buffer_WriteU8(&buffer, 0xAA);
+    BufferPool_Release(pool, &buffer);
+    TEST_ASSERT_NULL(buffer.data);
+    TEST_ASSERT_EQUAL(0, buffer.size);
+    TEST_ASSERT_EQUAL(0, buffer.written);
+
+    buffer = BufferPool_Acquire(pool, 65);
+    TEST_ASSERT_EQUAL_PTR(data, buffer.data);
+    TEST_ASSERT_EQUAL(128, buffer.size);
+    TEST_ASSERT_EQUAL(0, buffer.written);
+    BufferPool_Release(pool, &buffer);
+
+    BufferPool_GetStats(pool, &stats);
+    TEST_ASSERT_EQUAL(1, stats.hits);
+    TEST_ASSERT_EQUAL(1, stats.misses);
+    TEST_ASSERT_EQUAL(2, stats.releases);
+    TEST_ASSERT_EQUAL(0, stats.drops);
+    TEST_ASSERT_EQUAL(1, stats.cached);
+
+    BufferPool_Destroy(pool);
+}
+
+void test_BufferPool_Overflow(void)
+{
+    BufferPool * pool = BufferPool_Create(64, 64, 1);
+    BufferPoolStats stats;
+    Buffer buffer1, buffer2, big;
+
+    buffer1 = BufferPool_Acquire(pool, 1);
+    buffer2 = BufferPool_Acquire(pool, 64);
+    big = BufferPool_Acquire(pool, 1000);
+    TEST_ASSERT_EQUAL(64, buffer1.size);
+    TEST_ASSERT_EQUAL(64, buffer2.size);
+    TEST_ASSERT_EQUAL(1000, big.size);
+
+    BufferPool_Release(pool, &buffer1);
+    BufferPool_Release(pool, &buffer2);
+    BufferPool_Release(pool, &big);
+    TEST_ASSERT_NULL(buffer2.data);
+    TEST_ASSERT_NULL(big.data);
+
+    BufferPool_GetStats(pool, &stats);
+    TEST_ASSERT_EQUAL(0, stats.hits);
+    TEST_ASSERT_EQUAL(3, stats.misses);
+    TEST_ASSERT_EQUAL(1, stats.releases);
+    TEST_ASSERT_EQUAL(1, stats.drops);
+    TEST_ASSERT_EQUAL(1, stats.cached);
+
+    BufferPool_Destroy(pool);
+}
+
+void test_BufferPool_LargeSizes(void)
+{
+    BufferPool * pool = BufferPool_Create(64, SIZE_MAX, 4);
+    Buffer buffer;
+
+    TEST_ASSERT_NOT_NULL(pool);
+    buffer = BufferPool_Acquire(pool, 100);
+    TEST_ASSERT_EQUAL(128, buffer.size);
+    BufferPool_Release(pool, &buffer);
+    BufferPool_Destroy(pool);
+
+    TEST_ASSERT_NULL(BufferPool_Create(SIZE_MAX, 64, 4));
+    TEST_ASSERT_NULL(BufferPool_Create(64, 128, SIZE_MAX / 4));
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+#define POOL_HANDOFF_ROUNDS 1000
+
+struct _poolHandoff {
+    BufferPool * pool;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    Buffer buffer;
+    bool full;
+};
+
+static void * BufferPool_ReleaseThread(void * arg)
+{
+    struct _poolHandoff * handoff = arg;
+
+    for (int i = 0; i < POOL_HANDOFF_ROUNDS; i++) {
+        Buffer buffer;
+
+        pthread_mutex_lock(&handoff->lock);
+        while (!handoff->full) {
+            pthread_cond_wait(&handoff->changed, &handoff->lock);
+        }
+        buffer = handoff->buffer;
+        handoff->full = false;
+        pthread_cond_signal(&handoff->changed);
+        pthread_mutex_unlock(&handoff->lock);
+
+        BufferPool_Release(handoff->pool, &buffer);
+    }
+    return NULL;
+}
+
+void test_BufferPool_ReleaseFromOtherThread(void)
+{
+    struct _poolHandoff handoff = {
+            .pool = BufferPool_Create(64, 64, 4),
+    };
+    BufferPoolStats stats;
+    pthread_t thread;
+
+    TEST_ASSERT_NOT_NULL(handoff.pool);
+    pthread_mutex_init(&handoff.lock, NULL);
+    pthread_cond_init(&handoff.changed, NULL);
+    TEST_ASSERT_EQUAL(0, pthread_create(&thread, NULL, BufferPool_ReleaseThread, &handoff));
+
+    /* buffers are acquired here and released by the other thread */
+    for (int i = 0; i < POOL_HANDOFF_ROUNDS; i++) {
+        Buffer buffer = BufferPool_Acquire(handoff.pool, 64);
+
+        TEST_ASSERT_NOT_NULL(buffer.data);
+        Buffer_WriteU32(&buffer, (uint32_t)i);
+
+        pthread_mutex_lock(&handoff.lock);
+        while (handoff.full) {
+            pthread_cond_wait(&handoff.changed, &handoff.lock);
+        }
+        handoff.buffer = buffer;
+        handoff.full = true;
+        pthread_cond_signal(&handoff.changed);
+        pthread_mutex_unlock(&handoff.lock);
+    }
+    pthread_join(thread, NULL);
+
+    /* at most three buffers are out at once: acquired, handed off and being released */
+    BufferPool_GetStats(handoff.pool, &stats);
+    TEST_ASSERT_EQUAL(POOL_HANDOFF_ROUNDS, stats.hits + stats.misses);
+    TEST_ASSERT_LESS_OR_EQUAL(3, stats.misses);
+    TEST_ASSERT_EQUAL(POOL_HANDOFF_ROUNDS, stats.releases);
+    TEST_ASSERT_EQUAL(0, stats.drops);
+    TEST_ASSERT_EQUAL(stats.misses, stats.cached);
+
+    pthread_cond_destroy(&handoff.changed);
+    pthread_mutex_destroy(&handoff.lock);
+    BufferPool_Destroy(handoff.pool);
+}
+#endif
+
+void test_Buffer_WriteHex_ReadHex(void)
+{
+    uint8_t raw[100];
+    char text[256];
+    uint8_t decoded[128];
+
+    for (size_t i = 0; i < sizeof(raw); i++) {
+        raw[i] = (uint8_t)(i * 37 + 11);
+    }
+
+    Buffer buffer = {
+            .sdata = text,
+            .size = 2 * sizeof(raw) + 1,
+    };
+
+    Buffer_WriteHex(&buffer, "\x01\xab\xff", 3);
+    TEST_ASSERT_EQUAL(6, buffer.written);
+    TEST_ASSERT_EQUAL_CHAR_ARRAY("01abff", text, 6);
+
+    Buffer_WriteHex(&buffer, raw, sizeof(raw));
+    TEST_ASSERT_EQUAL(6, buffer.written);
+
+    Buffer_Clear(&buffer);
+    Buffer_WriteHex(&buffer, raw, sizeof(raw));
+    TEST_ASSERT_EQUAL(200, buffer.written);
+    TEST_ASSERT_EQUAL_CHAR_ARRAY("0b3055", text, 6);
+
+    ConstBuffer source = {
+            .sdata = text,
+            .size = buffer.written,
+    };
+    Buffer destination = {
+            .data = decoded,
+            .size = sizeof(decoded),
+    };
+
+    TEST_ASSERT_TRUE(Buffer_ReadHex(&source, &destination, 200));
+    TEST_ASSERT_EQUAL(100, destination.written);
+    TEST_ASSERT_EQUAL(0, Buffer_ReadAvailable(&source));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(raw, decoded, sizeof(raw));
+
+    source.read = 0;
+    TEST_ASSERT_FALSE(Buffer_ReadHex(&source, &destination, 200));
+    TEST_ASSERT_EQUAL(0, source.read);
+    TEST_ASSERT_EQUAL(100, destination.written);
+}
+
+void test_Buffer_ReadHex_Invalid(void)
+{
+    char text[64];
+    uint8_t decoded[32];
+
+    memset(text, 'A', sizeof(text));
+    text[40] = 'g';
+
+    ConstBuffer source = {
+            .sdata = text,
+            .size = sizeof(text),
+    };
+    Buffer destination = {
+            .data = decoded,
+            .size = sizeof(decoded),
+    };
+
+    TEST_ASSERT_FALSE(Buffer_ReadHex(&source, &destination, 3));
+    TEST_ASSERT_FALSE(Buffer_ReadHex(&source, &destination, 64));
+    TEST_ASSERT_EQUAL(0, source.read);
+    TEST_ASSERT_EQUAL(0, destination.written);
+
+    TEST_ASSERT_TRUE(Buffer_ReadHex(&source, &destination, 40));
+    TEST_ASSERT_EQUAL(20, destination.written);
+    TEST_ASSERT_EQUAL(0xaa, decoded[19]);
+}
+
+void test_Buffer_WriteBase64_ReadBase64(void)
+{
+    static const char * const vectors[][2] = {
+        {"", ""},
+        {"f", "Zg=="},
+        {"fo", "Zm8="},
+        {"foo", "Zm9v"},
+        {"foob", "Zm9vYg=="},
+        {"fooba", "Zm9vYmE="},
+        {"foobar", "Zm9vYmFy"},
+        {"Many hands make light work.", "TWFueSBoYW5kcyBtYWtlIGxpZ2h0IHdvcmsu"},
+    };
+    char text[64];
+    char decoded[64];
+
+    for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+        size_t rawSize = strlen(vectors[i][0]);
+        size_t encodedSize = strlen(vectors[i][1]);
+        Buffer buffer = {
+                .sdata = text,
+                .size = sizeof(text),
+        };
+
+        Buffer_WriteBase64(&buffer, vectors[i][0], rawSize);
+        TEST_ASSERT_EQUAL(encodedSize, buffer.written);
+        TEST_ASSERT_EQUAL_CHAR_ARRAY(vectors[i][1], text, encodedSize);
+
+        ConstBuffer source = {
+                .sdata = text,
+                .size = buffer.written,
+        };
+        Buffer destination = {
+                .sdata = decoded,
+                .size = sizeof(decoded),
+        };
+
+        TEST_ASSERT_TRUE(Buffer_ReadBase64(&source, &destination, encodedSize));
+        TEST_ASSERT_EQUAL(rawSize, destination.written);
+        TEST_ASSERT_EQUAL_CHAR_ARRAY(vectors[i][0], decoded, rawSize);
+    }
+}
+
+void test_Buffer_ReadBase64_Invalid(void)
+{
+    const char text[] = "Zm9v=mFyZm9vYmFy";
+    uint8_t decoded[4];
+    ConstBuffer source = {
+            .sdata = text,
+            .size = sizeof(text) - 1,
+    };
+    Buffer destination = {
+            .data = decoded,
+            .size = sizeof(decoded),
+    };
+
+    TEST_ASSERT_FALSE(Buffer_ReadBase64(&source, &destination, 6));
+    TEST_ASSERT_FALSE(Buffer_ReadBase64(&source, &destination, 8));
+    TEST_ASSERT_EQUAL(0, source.read);
+    TEST_ASSERT_EQUAL(0, destination.written);
+
+    TEST_ASSERT_TRUE(Buffer_ReadBase64(&source, &destination, 4));
+    TEST_ASSERT_EQUAL_CHAR_ARRAY("foo", decoded, 3);
+
+    source.read = 8;
+    TEST_ASSERT_FALSE(Buffer_ReadBase64(&source, &destination, 8));
+}
+
+void test_BitBuffer_WriteMsbFirst(void)
+{
+    uint8_t data[8];
+
+    memset(data, 0, sizeof(data));
+
+    Buffer buffer = {
+            .data = data,
+            .size = sizeof(data),
+    };
+    BitBuffer bits = BitBuffer_Init(&buffer, BIT_ORDER_MSB_FIRST);
+
+    BitBuffer_Write(&bits, 0x5, 3);
+    BitBuffer_Write(&bits, 0xabc, 12);
+    BitBuffer_Write(&bits, 0xff, 1);
+    TEST_ASSERT_EQUAL(0, buffer.written);
+
+    BitBuffer_Write(&bits, 0x12345678, 32);
+    TEST_ASSERT_EQUAL(4, buffer.written);
+
+    BitBuffer_Write(&bits, 0x3, 2);
+    BitBuffer_Flush(&bits);
+    TEST_ASSERT_EQUAL(7, buffer.written);
+
+    TEST_ASSERT_EQUAL(0xb5, data[0]);
+    TEST_ASSERT_EQUAL(0x79, data[1]);
+    TEST_ASSERT_EQUAL(0x12, data[2]);
+    TEST_ASSERT_EQUAL(0x34, data[3]);
+    TEST_ASSERT_EQUAL(0x56, data[4]);
+    TEST_ASSERT_EQUAL(0x78, data[5]);
+    TEST_ASSERT_EQUAL(0xc0, data[6]);
+    TEST_ASSERT_EQUAL(0x00, data[7]);
+}
+
+void test_BitBuffer_WriteLsbFirst(void)
+{
+    uint8_t data[4];
+
+    memset(data, 0, sizeof(data));
+
+    Buffer buffer = {
+            .data = data,
+            .size = sizeof(data),
+    };
+    BitBuffer bits = BitBuffer_Init(&buffer, BIT_ORDER_LSB_FIRST);
+
+    BitBuffer_Write(&bits, 0x5, 3);
+    BitBuffer_Write(&bits, 0xabc, 12);
+    BitBuffer_Write(&bits, 0x1, 1);
+    BitBuffer_Write(&bits, 0x3, 2);
+    BitBuffer_Flush(&bits);
+    TEST_ASSERT_EQUAL(3, buffer.written);
+
+    TEST_ASSERT_EQUAL(0xe5, data[0]);
+    TEST_ASSERT_EQUAL(0xd5, data[1]);
+    TEST_ASSERT_EQUAL(0x03, data[2]);
+}
+
+void test_BitBuffer_ReadWrite(void)
+{
+    static const uint8_t widths[] = {1, 3, 12, 7, 32, 64, 5, 33, 17, 0, 63, 2};
+    uint8_t data[64];
+
+    for (int order = BIT_ORDER_MSB_FIRST; order <= BIT_ORDER_LSB_FIRST; order++) {
+        Buffer buffer = {
+                .data = data,
+                .size = sizeof(data),
+        };
+        BitBuffer bits = BitBuffer_Init(&buffer, (BitOrder)order);
+        uint64_t val = 0x0123456789abcdefULL;
+
+        for (size_t i = 0; i < sizeof(widths); i++) {
+            BitBuffer_Write(&bits, val * (i + 1), widths[i]);
+        }
+        BitBuffer_Flush(&bits);
+        Buffer_WriteU8(&buffer, 0x42);
+
+        ConstBuffer source = {
+                .data = data,
+                .size = buffer.written,
+        };
+        ConstBitBuffer reader = ConstBitBuffer_Init(&source, (BitOrder)order);
+
+        for (size_t i = 0; i < sizeof(widths); i++) {
+            uint64_t expected = widths[i] < 64 ? (val * (i + 1)) & ((1ULL << widths[i]) - 1) : val * (i + 1);
+            TEST_ASSERT_EQUAL_UINT64(expected, BitBuffer_Read(&reader, widths[i]));
+        }
+
+        BitBuffer_ReadAlign(&reader);
+        TEST_ASSERT_EQUAL(0x42, Buffer_ReadU8(&source));
+        TEST_ASSERT_EQUAL(0, BitBuffer_ReadAvailable(&reader));
+        TEST_ASSERT_EQUAL_UINT64(0, BitBuffer_Read(&reader, 1));
+    }
+}
+
+void test_SharedBuffer_Share(void)
+{
+    SharedBuffer * shared = SharedBuffer_Alloc(8);
+    SharedConstBuffer first, second;
+
+    TEST_ASSERT_NOT_NULL(shared);
+    TEST_ASSERT_EQUAL(8, SharedBuffer_GetBuffer(shared)->size);
+
+    Buffer_WriteU32(SharedBuffer_GetBuffer(shared), 0x11223344UL);
+
+    first = SharedBuffer_Share(shared);
+    SharedBuffer_Release(shared);
+    TEST_ASSERT_EQUAL(4, Buffer_ReadAvailable(&first.buff));
+    TEST_ASSERT_EQUAL_UINT16(0x1122, Buffer_ReadU16(&first.buff));
+
+    second = SharedConstBuffer_Copy(&first);
+    SharedConstBuffer_Release(&first);
+    TEST_ASSERT_NULL(first.owner);
+    TEST_ASSERT_NULL(first.buff.data);
+
+    TEST_ASSERT_EQUAL(4, Buffer_ReadAvailable(&second.buff));
+    TEST_ASSERT_EQUAL_UINT32(0x11223344UL, Buffer_ReadU32(&second.buff));
+    SharedConstBuffer_Release(&second);
+}
+
+void test_SharedBuffer_NotOwned(void)
+{
+    SharedBuffer * shared = SharedBuffer_Alloc(8);
+    Buffer * buffer = SharedBuffer_GetBuffer(shared);
+    Buffer copy;
+
+    TEST_ASSERT_NOT_NULL(shared);
+    TEST_ASSERT_EQUAL(BUFFER_ALLOC_NONE, buffer->alloc);
+    TEST_ASSERT_FALSE(Buffer_Reserve(buffer, 9));
+    TEST_ASSERT_EQUAL(8, buffer->size);
+
+    /* data stay in the shared allocation, they are released with it */
+    copy = *buffer;
+    Buffer_FreeData(&copy);
+    TEST_ASSERT_NULL(copy.data);
+
+    Buffer_WriteU64(buffer, 1);
+    TEST_ASSERT_EQUAL(8, buffer->written);
+    SharedBuffer_Release(shared);
+}
+
+void test_Buffer_WriteArray_ReadArray(void)
+{
+    const uint16_t u16[] = {0x1122, 0x3344};
+    const uint32_t u32[] = {0x11223344UL};
+    const uint64_t u64[] = {0x1122334455667788ULL};
+    uint8_t data[16];
+    uint16_t r16[2];
+    uint32_t r32[1];
+    uint64_t r64[1];
+
+    Buffer buffer = {
+            .data = data,
+            .size = sizeof(data),
+    };
+
+    Buffer_WriteArray(&buffer, u16, 2, sizeof(u16[0]));
+    Buffer_WriteArray(&buffer, u32, 1, sizeof(u32[0]));
+    Buffer_WriteArray(&buffer, u64, 1, sizeof(u64[0]));
+    TEST_ASSERT_EQUAL(16, buffer.written);
+    TEST_ASSERT_EQUAL(0x11, data[0]);
+    TEST_ASSERT_EQUAL(0x44, data[3]);
+    TEST_ASSERT_EQUAL(0x11, data[4]);
+    TEST_ASSERT_EQUAL(0x88, data[15]);
+
+    Buffer_WriteArray(&buffer, u16, 1, sizeof(u16[0]));
+    TEST_ASSERT_EQUAL(16, buffer.written);
+
+    ConstBuffer source = {
+            .data = data,
+            .size = buffer.written,
+    };
+
+    TEST_ASSERT_TRUE(Buffer_ReadArray(&source, r16, 2, sizeof(r16[0])));
+    TEST_ASSERT_TRUE(Buffer_ReadArray(&source, r32, 1, sizeof(r32[0])));
+    TEST_ASSERT_TRUE(Buffer_ReadArray(&source, r64, 1, sizeof(r64[0])));
+    TEST_ASSERT_EQUAL_UINT16(0x3344, r16[1]);
+    TEST_ASSERT_EQUAL_UINT32(0x11223344UL, r32[0]);
+    TEST_ASSERT_EQUAL_UINT64(0x1122334455667788ULL, r64[0]);
+    TEST_ASSERT_FALSE(Buffer_ReadArray(&source, r16, 1, sizeof(r16[0])));
+}
+
+void test_Buffer_ArrayParallel(void)
+{
+    const size_t count = 300000;
+    BufferWorkers * workers = BufferWorkers_Create(4);
+    uint64_t * values = malloc(count * sizeof(uint64_t));
+    uint64_t * decoded = malloc(count * sizeof(uint64_t));
+    Buffer buffer = Buffer_AllocData(count * 10);
+    size_t encodedSize;
+
+    for (size_t i = 0; i < count; i++) {
+        values[i] = (uint64_t)i * i * 2654435761ULL >> (i % 60);
+    }
+
+    Buffer_WriteArrayParallel(workers, &buffer, values, count, sizeof(uint64_t));
+    TEST_ASSERT_EQUAL(count * 8, buffer.written);
+    TEST_ASSERT_EQUAL(values[count - 1] & 0xff, buffer.data[count * 8 - 1]);
+
+    ConstBuffer source = {
+            .data = buffer.data,
+            .size = buffer.written,
+    };
+    TEST_ASSERT_TRUE(Buffer_ReadArrayParallel(workers, &source, decoded, count, sizeof(uint64_t)));
+    TEST_ASSERT_EQUAL_MEMORY(values, decoded, count * sizeof(uint64_t));
+
+    Buffer_Clear(&buffer);
+    encodedSize = Buffer_WriteVarArrayParallel(workers, &buffer, values, count);
+    TEST_ASSERT_EQUAL(encodedSize, buffer.written);
+
+    source.size = buffer.written;
+    source.read = 0;
+    TEST_ASSERT_EQUAL_UINT64(values[0], Buffer_ReadVarU64(&source));
+    TEST_ASSERT_EQUAL_UINT64(values[1], Buffer_ReadVarU64(&source));
+
+    source.read = 0;
+    memset(decoded, 0, count * sizeof(uint64_t));
+    TEST_ASSERT_FALSE(Buffer_ReadVarArrayParallel(workers, &source, decoded, count - 1, encodedSize));
+    TEST_ASSERT_TRUE(Buffer_ReadVarArrayParallel(workers, &source, decoded, count, encodedSize));
+    TEST_ASSERT_EQUAL_MEMORY(values, decoded, count * sizeof(uint64_t));
+    TEST_ASSERT_EQUAL(0, Buffer_ReadAvailable(&source));
+
+    Buffer_FreeData(&buffer);
+    free(decoded);
+    free(values);
+    BufferWorkers_Destroy(workers);
+}
+
+void test_Buffer_Compress_Decompress(void)
+{
+    const size_t size = 10000;
+    Buffer raw = Buffer_AllocData(size);
+    Buffer compressed = Buffer_AllocData(Buffer_CompressBound(size));
+    Buffer decompressed = Buffer_AllocData(size);
+    BufferCompressTable * table = malloc(sizeof(*table));
+
+    while (Buffer_WriteAvailable(&raw) > 0) {
+        Buffer_Format(&raw, "sample %u;", (unsigned)(raw.written % 7));
+    }
+    raw.written = size;
+
+    ConstBuffer source = {
+            .data = raw.data,
+            .size = raw.written,
+    };
+    TEST_ASSERT_TRUE(Buffer_Compress(&compressed, &source, table));
+    TEST_ASSERT_EQUAL(0, Buffer_ReadAvailable(&source));
+    TEST_ASSERT_LESS_THAN(size / 4, compressed.written);
+
+    ConstBuffer packed = {
+            .data = compressed.data,
+            .size = compressed.written,
+    };
+    TEST_ASSERT_FALSE(Buffer_Decompress(&decompressed, &packed, compressed.written - 1));
+    TEST_ASSERT_EQUAL(0, packed.read);
+    TEST_ASSERT_TRUE(Buffer_Decompress(&decompressed, &packed, compressed.written));
+    TEST_ASSERT_EQUAL(size, decompressed.written);
+    TEST_ASSERT_EQUAL_MEMORY(raw.data, decompressed.data, size);
+
+    Buffer small = Buffer_AllocData(16);
+    source.read = 0;
+    TEST_ASSERT_FALSE(Buffer_Compress(&small, &source, table));
+    TEST_ASSERT_EQUAL(0, source.read);
+    TEST_ASSERT_EQUAL(0, small.written);
+
+    Buffer_FreeData(&small);
+    Buffer_FreeData(&raw);
+    Buffer_FreeData(&compressed);
+    Buffer_FreeData(&decompressed);
+    free(table);
+}
+
+static bool Compressed_FlushToBuffer(void * ctx, ConstBuffer * frame)
+{
+    Buffer * stream = ctx;
+
+    Buffer_Write(stream, frame->data, frame->size);
+    return true;
+}
+
+static bool Compressed_FlushFail(void * ctx, ConstBuffer * frame)
+{
+    (void)ctx;
+    (void)frame;
+    return false;
+}
+
+static bool Compressed_RefillByByte(void * ctx, Buffer * buff)
+{
+    ConstBuffer * stream = ctx;
+
+    if (Buffer_ReadAvailable(stream) == 0) {
+        return false;
+    }
+    Buffer_WriteU8(buff, Buffer_ReadU8(stream));
+    return true;
+}
+
+void test_CompressedWriter_Reader(void)
+{
+    Buffer stream = Buffer_AllocData(1024);
+    CompressedWriter writer;
+    CompressedReader reader;
+    ConstBuffer * block;
+
+    TEST_ASSERT_TRUE(CompressedWriter_Init(&writer, 256, Compressed_FlushToBuffer, &stream));
+    memset(CompressedWriter_GetBuffer(&writer)->data, 'x', 200);
+    CompressedWriter_GetBuffer(&writer)->written = 200;
+    TEST_ASSERT_TRUE(CompressedWriter_Flush(&writer));
+    TEST_ASSERT_LESS_THAN(50, stream.written);
+
+    /* failed flush keeps the data for retry */
+    Buffer_Write(CompressedWriter_GetBuffer(&writer), "abc", 3);
+    writer.flush = Compressed_FlushFail;
+    TEST_ASSERT_FALSE(CompressedWriter_Flush(&writer));
+    TEST_ASSERT_EQUAL(3, CompressedWriter_GetBuffer(&writer)->written);
+    writer.flush = Compressed_FlushToBuffer;
+    TEST_ASSERT_TRUE(CompressedWriter_Flush(&writer));
+    TEST_ASSERT_TRUE(CompressedWriter_Flush(&writer));
+    CompressedWriter_Deinit(&writer);
+
+    ConstBuffer source = {
+            .data = stream.data,
+            .size = stream.written,
+    };
+    TEST_ASSERT_TRUE(CompressedReader_Init(&reader, 256, Compressed_RefillByByte, &source));
+
+    block = CompressedReader_Next(&reader);
+    TEST_ASSERT_NOT_NULL(block);
+    TEST_ASSERT_EQUAL(200, Buffer_ReadAvailable(block));
+    TEST_ASSERT_EQUAL('x', block->data[199]);
+
+    block = CompressedReader_Next(&reader);
+    TEST_ASSERT_NOT_NULL(block);
+    TEST_ASSERT_EQUAL(3, Buffer_ReadAvailable(block));
+    TEST_ASSERT_EQUAL_CHAR_ARRAY("abc", block->data, 3);
+
+    TEST_ASSERT_NULL(CompressedReader_Next(&reader));
+    CompressedReader_Deinit(&reader);
+    Buffer_FreeData(&stream);
+}
+
+void test_Buffer_WriteTlv_ReadTlv(void)
+{
+    uint8_t data[16];
+    Buffer buffer = {
+            .data = data,
+            .size = sizeof(data),
+    };
+    ConstBuffer value;
+    uint8_t tag;
+
+    Buffer_WriteTlv(&buffer, 0x10, "ab", 2);
+    Buffer_WriteTlv(&buffer, 0x20, "", 0);
+    Buffer_WriteTlv(&buffer, 0x30, "cdefghijk", 9);
+    TEST_ASSERT_EQUAL(8, buffer.written);
+    TEST_ASSERT_EQUAL(0x10, data[0]);
+    TEST_ASSERT_EQUAL(0x00, data[1]);
+    TEST_ASSERT_EQUAL(0x02, data[2]);
+    TEST_ASSERT_EQUAL_CHAR_ARRAY("ab", data + 3, 2);
+
+    ConstBuffer source = {
+            .data = data,
+            .size = buffer.written,
+    };
+    TEST_ASSERT_TRUE(Buffer_ReadTlv(&source, &tag, &value));
+    TEST_ASSERT_EQUAL(0x10, tag);
+    TEST_ASSERT_EQUAL(2, value.size);
+    TEST_ASSERT_EQUAL_PTR(data + 3, value.data);
+    TEST_ASSERT_TRUE(Buffer_ReadTlv(&source, &tag, &value));
+    TEST_ASSERT_EQUAL(0x20, tag);
+    TEST_ASSERT_EQUAL(0, value.size);
+    TEST_ASSERT_FALSE(Buffer_ReadTlv(&source, &tag, &value));
+
+    source.size = 7;
+    source.read = 5;
+    data[7] = 1;
+    TEST_ASSERT_FALSE(Buffer_ReadTlv(&source, &tag, &value));
+    TEST_ASSERT_EQUAL(5, source.read);
+}
+
+void test_TlvIndex(void)
+{
+    uint8_t data[32];
+    Buffer buffer = {
+            .data = data,
+            .size = sizeof(data),
+    };
+    TlvIndex index;
+    ConstBuffer value;
+
+    Buffer_WriteU8(&buffer, 0xAA);
+    Buffer_WriteTlv(&buffer, 1, "one", 3);
+    Buffer_WriteTlv(&buffer, 2, "two", 3);
+    Buffer_WriteTlv(&buffer, 255, "last", 4);
+    Buffer_WriteTlv(&buffer, 1, "again", 5);
+
+    ConstBuffer record = {
+            .data = data,
+            .size = buffer.written,
+            .read = 1,
+    };
+    TEST_ASSERT_TRUE(TlvIndex_Build(&index, &record));
+
+    TEST_ASSERT_TRUE(TlvIndex_Get(&index, &record, 255, &value));
+    TEST_ASSERT_EQUAL(4, value.size);
+    TEST_ASSERT_EQUAL_CHAR_ARRAY("last", value.data, 4);
+    TEST_ASSERT_TRUE(TlvIndex_Get(&index, &record, 1, &value));
+    TEST_ASSERT_EQUAL_CHAR_ARRAY("one", value.data, 3);
+    TEST_ASSERT_TRUE(TlvIndex_Get(&index, &record, 2, &value));
+    TEST_ASSERT_EQUAL_CHAR_ARRAY("two", value.data, 3);
+    TEST_ASSERT_FALSE(TlvIndex_Get(&index, &record, 0, &value));
+    TEST_ASSERT_EQUAL(1, record.read);
+
+    record.size--;
+    TEST_ASSERT_FALSE(TlvIndex_Build(&index, &record));
+}
+
+static const int64_t deltaValues[] = {
+    1700000000000LL, 1700000000010LL, 1700000000020LL, 1700000000030LL, 1700000000041LL,
+    1700000000050LL, 1700000000060LL, 1700000000070LL, 1700000000080LL, 1700000000090LL,
+};
+
+void test_Buffer_Delta(void)
+{
+    uint8_t data[64];
+    int64_t decoded[10];
+    size_t count;
+    Buffer buffer = {
+            .data = data,
+            .size = sizeof(data),
+    };
+
+    Buffer_WriteDelta(&buffer, deltaValues, 10);
+    TEST_ASSERT_EQUAL(1 + 6 + 9, buffer.written);
+    TEST_ASSERT_EQUAL(10, data[0]);
+    TEST_ASSERT_EQUAL(20, data[7]);
+
+    ConstBuffer source = {
+            .data = data,
+            .size = buffer.written,
+    };
+    TEST_ASSERT_FALSE(Buffer_ReadDelta(&source, decoded, 9, &count));
+    TEST_ASSERT_EQUAL(0, source.read);
+    TEST_ASSERT_TRUE(Buffer_ReadDelta(&source, decoded, 10, &count));
+    TEST_ASSERT_EQUAL(10, count);
+    TEST_ASSERT_EQUAL_INT64_ARRAY(deltaValues, decoded, 10);
+    TEST_ASSERT_EQUAL(0, Buffer_ReadAvailable(&source));
+
+    buffer.size = 10;
+    Buffer_Clear(&buffer);
+    Buffer_WriteDelta(&buffer, deltaValues, 10);
+    TEST_ASSERT_EQUAL(0, buffer.written);
+}
+
+void test_Buffer_DeltaOfDelta(void)
+{
+    const int64_t extremes[] = {INT64_MAX, INT64_MIN, 0, -1, INT64_MAX};
+    uint8_t data[64];
+    int64_t decoded[10];
+    size_t count;
+    Buffer buffer = {
+            .data = data,
+            .size = sizeof(data),
+    };
+
+    Buffer_WriteDeltaOfDelta(&buffer, deltaValues, 10);
+    TEST_ASSERT_EQUAL(1 + 6 + 1 + 8, buffer.written);
+    TEST_ASSERT_EQUAL(20, data[7]);
+    TEST_ASSERT_EQUAL(0, data[8]);
+
+    ConstBuffer source = {
+            .data = data,
+            .size = buffer.written,
+    };
+    TEST_ASSERT_TRUE(Buffer_ReadDeltaOfDelta(&source, decoded, 10, &count));
+    TEST_ASSERT_EQUAL(10, count);
+    TEST_ASSERT_EQUAL_INT64_ARRAY(deltaValues, decoded, 10);
+
+    Buffer_Clear(&buffer);
+    Buffer_WriteDeltaOfDelta(&buffer, extremes, 5);
+    source.size = buffer.written;
+    source.read = 0;
+    TEST_ASSERT_TRUE(Buffer_ReadDeltaOfDelta(&source, decoded, 10, &count));
+    TEST_ASSERT_EQUAL(5, count);
+    TEST_ASSERT_EQUAL_INT64_ARRAY(extremes, decoded, 5);
+}
+
+void test_Buffer_DeltaPacked(void)
+{
+    const int64_t extremes[] = {INT64_MAX, INT64_MIN, 0, -1, INT64_MAX};
+    uint8_t data[64];
+    int64_t decoded[10];
+    size_t count;
+    Buffer buffer = {
+            .data = data,
+            .size = sizeof(data),
+    };
+
+    Buffer_WriteDeltaPacked(&buffer, deltaValues, 10);
+    /* differences are 9 to 11, packed by 2 bits */
+    TEST_ASSERT_EQUAL(18, data[7]);
+    TEST_ASSERT_EQUAL(2, data[8]);
+    TEST_ASSERT_EQUAL(1 + 6 + 1 + 1 + 3, buffer.written);
+
+    ConstBuffer source = {
+            .data = data,
+            .size = buffer.written,
+    };
+    TEST_ASSERT_TRUE(Buffer_ReadDeltaPacked(&source, decoded, 10, &count));
+    TEST_ASSERT_EQUAL(10, count);
+    TEST_ASSERT_EQUAL_INT64_ARRAY(deltaValues, decoded, 10);
+    TEST_ASSERT_EQUAL(0, Buffer_ReadAvailable(&source));
+
+    Buffer_Clear(&buffer);
+    Buffer_WriteDeltaPacked(&buffer, extremes, 5);
+    source.size = buffer.written;
+    source.read = 0;
+    TEST_ASSERT_TRUE(Buffer_ReadDeltaPacked(&source, decoded, 10, &count));
+    TEST_ASSERT_EQUAL(5, count);
+    TEST_ASSERT_EQUAL_INT64_ARRAY(extremes, decoded, 5);
+
+    source.size--;
+    source.read = 0;
+    TEST_ASSERT_FALSE(Buffer_ReadDeltaPacked(&source, decoded, 10, &count));
+    TEST_ASSERT_EQUAL(0, source.read);
+}
+
+void test_Buffer_WriteColumns_ReadColumns(void)
+{
+    uint8_t data[37 * 16];
+    uint8_t types[37], decodedTypes[37];
+    uint16_t ports[37], decodedPorts[37];
+    uint32_t ids[37], decodedIds[37];
+    uint64_t times[37], decodedTimes[37];
+    Buffer buffer = {
+            .data = data,
+            .size = sizeof(data),
+    };
+
+    for (size_t i = 0; i < 37; i++) {
+        types[i] = (uint8_t)i;
+        ports[i] = (uint16_t)(0x1000 + i);
+        ids[i] = 0x01020300 + (uint32_t)i;
+        times[i] = 0x1112131415161700 + i;
+    }
+
+    BufferColumn columns[] = {
+            {.offset = 0, .size = 1, .data = types},
+            {.offset = 2, .size = 2, .data = ports},
+            {.offset = 4, .size = 4, .data = ids},
+            {.offset = 8, .size = 8, .data = times},
+    };
+    TEST_ASSERT_TRUE(Buffer_WriteColumns(&buffer, 16, columns, 4, 37));
+    TEST_ASSERT_EQUAL(sizeof(data), buffer.written);
+
+    const uint8_t record[] = {3, 0, 0x10, 0x03, 0x01, 0x02, 0x03, 0x03, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x03};
+    TEST_ASSERT_EQUAL_MEMORY(record, data + 3 * 16, sizeof(record));
+    TEST_ASSERT_FALSE(Buffer_WriteColumns(&buffer, 16, columns, 4, 1));
+
+    BufferColumn decoded[] = {
+            {.offset = 0, .size = 1, .data = decodedTypes},
+            {.offset = 2, .size = 2, .data = decodedPorts},
+            {.offset = 4, .size = 4, .data = decodedIds},
+            {.offset = 8, .size = 8, .data = decodedTimes},
+    };
+    ConstBuffer source = {
+            .data = data,
+            .size = buffer.written,
+    };
+    TEST_ASSERT_FALSE(Buffer_ReadColumns(&source, 16, decoded, 4, 38));
+    TEST_ASSERT_EQUAL(0, source.read);
+    TEST_ASSERT_TRUE(Buffer_ReadColumns(&source, 16, decoded, 4, 37));
+    TEST_ASSERT_EQUAL(sizeof(data), source.read);
+    TEST_ASSERT_EQUAL_MEMORY(types, decodedTypes, sizeof(types));
+    TEST_ASSERT_EQUAL_MEMORY(ports, decodedPorts, sizeof(ports));
+    TEST_ASSERT_EQUAL_MEMORY(ids, decodedIds, sizeof(ids));
+    TEST_ASSERT_EQUAL_MEMORY(times, decodedTimes, sizeof(times));
+
+    decoded[3].offset = 9;
+    source.read = 0;
+    TEST_ASSERT_FALSE(Buffer_ReadColumns(&source, 16, decoded, 4, 1));
+}
+
+void test_BufferCpu_Levels(void)
+{
+    static uint8_t input[301];
+    static uint8_t expected[2][2048];
+    static uint8_t encoded[2048];
+    static uint64_t values[75];
+    static uint64_t decodedValues[75];
+    static uint32_t column[18];
+    BufferCpuLevel supported = BufferCpu_GetLevel();
+
+    for (size_t i = 0; i < sizeof(input); i++) {
+        input[i] = (uint8_t)(i * 37 + 11);
+    }
+    for (size_t i = 0; i < 75; i++) {
+        values[i] = 0x0102030405060708ULL * i + 1;
+    }
+
+    for (int level = BUFFER_CPU_SCALAR; level <= BUFFER_CPU_AVX512; level++) {
+        Buffer buffer = {
+                .data = encoded,
+                .size = sizeof(encoded),
+        };
+        size_t count;
+
+        if (BufferCpu_SetLevel((BufferCpuLevel)level) != (BufferCpuLevel)level) {
+            break;
+        }
+
+        Buffer_WriteHex(&buffer, input, sizeof(input));
+        Buffer_WriteBase64(&buffer, input, sizeof(input));
+        Buffer_WriteArray(&buffer, values, 75, 8);
+        Buffer_WriteArray(&buffer, values, 75, 2);
+        if (level == BUFFER_CPU_SCALAR) {
+            memcpy(expected[0], encoded, buffer.written);
+        } else {
+            TEST_ASSERT_EQUAL_MEMORY(expected[0], encoded, buffer.written);
+        }
+
+        ConstBuffer source = {
+                .data = encoded,
+                .size = buffer.written,
+        };
+        Buffer decoded = {
+                .data = expected[1],
+                .size = sizeof(expected[1]),
+        };
+        TEST_ASSERT_TRUE(Buffer_ReadHex(&source, &decoded, 2 * sizeof(input)));
+        TEST_ASSERT_EQUAL_MEMORY(input, expected[1], sizeof(input));
+        source.read += (sizeof(input) + 2) / 3 * 4;
+        TEST_ASSERT_TRUE(Buffer_ReadArray(&source, decodedValues, 75, 8));
+        TEST_ASSERT_EQUAL_MEMORY(values, decodedValues, sizeof(values));
+
+        /* every third 32-bit word of the array as a column */
+        BufferColumn columns[] = {{.offset = 4, .size = 4, .data = column}};
+        source.read = 2 * sizeof(input) + (sizeof(input) + 2) / 3 * 4;
+        TEST_ASSERT_TRUE(Buffer_ReadColumns(&source, 32, columns, 1, 18));
+        for (size_t i = 0; i < 18; i++) {
+            TEST_ASSERT_EQUAL_UINT32((uint32_t)values[4 * i], column[i]);
+        }
+
+        Buffer_Clear(&buffer);
+        Buffer_WriteDelta(&buffer, (const int64_t *)values, 75);
+        source.size = buffer.written;
+        source.read = 0;
+        TEST_ASSERT_TRUE(Buffer_ReadDelta(&source, (int64_t *)decodedValues, 75, &count));
+        TEST_ASSERT_EQUAL_MEMORY(values, decodedValues, sizeof(values));
+    }
+
+    BufferCpu_SetLevel(supported);
+    TEST_ASSERT_EQUAL(supported, BufferCpu_GetLevel());
+}
+
+void test_Buffer_WriteDictStr_ReadDictStr(void)
+{
+    const char * names[] = {"sensor-a", "sensor-b", "sensor-a", "overflow", "sensor-b", "overflow"};
+    BufferDict * writer = BufferDict_Create(2, 64);
+    BufferDict * reader = BufferDict_Create(2, 64);
+    uint8_t data[64];
+    Buffer buffer = {
+            .data = data,
+            .size = sizeof(data),
+    };
+    ConstBuffer str;
+
+    TEST_ASSERT_NOT_NULL(writer);
+    TEST_ASSERT_NOT_NULL(reader);
+
+    for (size_t i = 0; i < 6; i++) {
+        Buffer_WriteDictStr(&buffer, writer, names[i], strlen(names[i]));
+    }
+    /* dictionary is full after two strings, the third one is always written whole */
+    TEST_ASSERT_EQUAL(2, BufferDict_Count(writer));
+    TEST_ASSERT_EQUAL(10 + 10 + 1 + 10 + 1 + 10, buffer.written);
+    TEST_ASSERT_EQUAL(1, data[20]);
+    TEST_ASSERT_EQUAL(2, data[31]);
+
+    ConstBuffer source = {
+            .data = data,
+            .size = buffer.written,
+    };
+    for (size_t i = 0; i < 6; i++) {
+        TEST_ASSERT_TRUE(Buffer_ReadDictStr(&source, reader, &str));
+        TEST_ASSERT_EQUAL(strlen(names[i]), str.size);
+        TEST_ASSERT_EQUAL_MEMORY(names[i], str.data, str.size);
+    }
+    TEST_ASSERT_EQUAL(0, Buffer_ReadAvailable(&source));
+    TEST_ASSERT_EQUAL(2, BufferDict_Count(reader));
+
+    /* views point to the dictionary, not to the buffer */
+    source.read = 20;
+    TEST_ASSERT_TRUE(Buffer_ReadDictStr(&source, reader, &str));
+    TEST_ASSERT_TRUE(str.data < data || str.data >= data + sizeof(data));
+
+    /* unknown id */
+    BufferDict_Clear(reader);
+    source.read = 20;
+    TEST_ASSERT_FALSE(Buffer_ReadDictStr(&source, reader, &str));
+    TEST_ASSERT_EQUAL(20, source.read);
+
+    /* nothing is added when the string does not fit */
+    BufferDict_Clear(writer);
+    buffer.size = 5;
+    Buffer_Clear(&buffer);
+    Buffer_WriteDictStr(&buffer, writer, "sensor-a", 8);
+    TEST_ASSERT_EQUAL(0, buffer.written);
+    TEST_ASSERT_EQUAL(0, BufferDict_Count(writer));
+
+    BufferDict_Destroy(writer);
+    BufferDict_Destroy(reader);
+}
+
+void test_BufferSizer(void)
+{
+    BufferSizer * sizer = BufferSizer_Create("test", 64, 4096, 99.0);
+    Buffer buffer;
+
+    TEST_ASSERT_NOT_NULL(sizer);
+    TEST_ASSERT_EQUAL_STRING("test", BufferSizer_GetName(sizer));
+    TEST_ASSERT_EQUAL(64, BufferSizer_Suggest(sizer));
+    TEST_ASSERT_EQUAL(0, BufferSizer_Percentile(sizer, 50.0));
+
+    BufferSizer_Record(sizer, 10);
+    TEST_ASSERT_EQUAL(64, BufferSizer_Suggest(sizer));
+
+    for (size_t i = 1; i < 1000; i++) {
+        BufferSizer_Record(sizer, 100);
+    }
+    for (size_t i = 0; i < 24; i++) {
+        BufferSizer_Record(sizer, 5000);
+    }
+    /* buckets are 96 to 111 and 4096 to 5119 */
+    TEST_ASSERT_EQUAL(111, BufferSizer_Percentile(sizer, 95.0));
+    TEST_ASSERT_EQUAL(5119, BufferSizer_Percentile(sizer, 99.0));
+    TEST_ASSERT_EQUAL(4096, BufferSizer_Suggest(sizer));
+
+    buffer = BufferSizer_Alloc(sizer);
+    TEST_ASSERT_NOT_NULL(buffer.data);
+    TEST_ASSERT_EQUAL(4096, buffer.size);
+    Buffer_WriteU32(&buffer, 1);
+    BufferSizer_Free(sizer, &buffer);
+    TEST_ASSERT_NULL(buffer.data);
+
+    BufferSizer_Destroy(sizer);
+    TEST_ASSERT_NULL(BufferSizer_Create("test", 64, 32, 99.0));
+}
+
+void test_Buffer_WriteNonTemporal_ReadNonTemporal(void)
+{
+    const size_t size = 1024 * 1024 + 13;
+    uint8_t * input = malloc(size);
+    uint8_t * output = malloc(size + 1);
+    Buffer buffer = Buffer_AllocData(size + 3);
+    BufferCpuLevel supported = BufferCpu_GetLevel();
+
+    TEST_ASSERT_NOT_NULL(input);
+    TEST_ASSERT_NOT_NULL(output);
+    TEST_ASSERT_NOT_NULL(buffer.data);
+
+    for (size_t i = 0; i < size; i++) {
+        input[i] = (uint8_t)(i * 7 + (i >> 12));
+    }
+
+    for (int level = BUFFER_CPU_SCALAR; level <= BUFFER_CPU_AVX512; level++) {
+        if (BufferCpu_SetLevel((BufferCpuLevel)level) != (BufferCpuLevel)level) {
+            break;
+        }
+
+        /* unaligned destination */
+        Buffer_Clear(&buffer);
+        Buffer_WriteU8(&buffer, 1);
+        Buffer_WriteNonTemporal(&buffer, input, size);
+        TEST_ASSERT_EQUAL(size + 1, buffer.written);
+        TEST_ASSERT_EQUAL_MEMORY(input, buffer.data + 1, size);
+
+        ConstBuffer source = {
+                .data = buffer.data,
+                .size = buffer.written,
+                .read = 1,
+        };
+        memset(output, 0, size + 1);
+        TEST_ASSERT_TRUE(Buffer_ReadNonTemporal(&source, output + 1, size));
+        TEST_ASSERT_EQUAL_MEMORY(input, output + 1, size);
+        TEST_ASSERT_FALSE(Buffer_ReadNonTemporal(&source, output, 1));
+
+        Buffer_WriteNonTemporal(&buffer, input, 2);
+        Buffer_WriteNonTemporal(&buffer, input, 2);
+        TEST_ASSERT_EQUAL(size + 3, buffer.written);
+    }
+
+    BufferCpu_SetLevel(supported);
+    Buffer_FreeData(&buffer);
+    free(output);
+    free(input);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+static void BufferIo_CountCallback(void * ctx, long result)
+{
+    long * total = ctx;
+    *total += result;
+}
+
+static void BufferIo_Test(BufferIoBackend backend)
+{
+    BufferIo * io = BufferIo_Create(8, backend);
+    FILE * file = tmpfile();
+    int pipeFds[2];
+    long total = 0;
+    uint8_t readData[16];
+
+    if (io == NULL) {
+        fclose(file);
+        TEST_ASSERT_EQUAL(BUFFER_IO_URING, backend);
+        TEST_IGNORE_MESSAGE("io_uring is not available");
+    }
+    TEST_ASSERT_EQUAL(backend, BufferIo_GetBackend(io));
+
+    Buffer first = Buffer_AllocData(8);
+    Buffer second = Buffer_AllocData(8);
+    Buffer_WriteU64(&first, 0x6162636465666768ULL);
+    Buffer_WriteU32(&second, 0x30313233UL);
+    TEST_ASSERT_TRUE(BufferIo_RegisterBuffers(io, &first, 1));
+
+    TEST_ASSERT_TRUE(BufferIo_SubmitWrite(io, fileno(file), 0, &first, BufferIo_CountCallback, &total));
+    TEST_ASSERT_TRUE(BufferIo_SubmitWrite(io, fileno(file), 8, &second, BufferIo_CountCallback, &total));
+    TEST_ASSERT_EQUAL(2, BufferIo_InFlight(io));
+    TEST_ASSERT_EQUAL(2, BufferIo_Flush(io));
+    while (BufferIo_InFlight(io) > 0) {
+        BufferIo_Poll(io, true);
+    }
+    TEST_ASSERT_EQUAL(12, total);
+
+    Buffer destination = {
+            .data = readData,
+            .size = sizeof(readData),
+    };
+    total = 0;
+    TEST_ASSERT_TRUE(BufferIo_SubmitRead(io, fileno(file), 0, &destination, BufferIo_CountCallback, &total));
+    while (BufferIo_InFlight(io) > 0) {
+        BufferIo_Poll(io, true);
+    }
+    TEST_ASSERT_EQUAL(12, total);
+    TEST_ASSERT_EQUAL(12, destination.written);
+    TEST_ASSERT_EQUAL_CHAR_ARRAY("abcdefgh0123", readData, 12);
+
+    TEST_ASSERT_EQUAL(0, pipe(pipeFds));
+    ConstBuffer source = {
+            .data = readData,
+            .size = destination.written,
+            .read = 4,
+    };
+    TEST_ASSERT_TRUE(BufferIo_SubmitWriteConst(io, pipeFds[1], -1, &source, NULL, NULL));
+    BufferIo_Destroy(io);
+    TEST_ASSERT_EQUAL(0, Buffer_ReadAvailable(&source));
+
+    memset(readData, 0, sizeof(readData));
+    TEST_ASSERT_EQUAL(8, read(pipeFds[0], readData, sizeof(readData)));
+    TEST_ASSERT_EQUAL_CHAR_ARRAY("efgh0123", readData, 8);
+
+    close(pipeFds[0]);
+    close(pipeFds[1]);
+    fclose(file);
+    Buffer_FreeData(&first);
+    Buffer_FreeData(&second);
+}
+
+static void BufferIo_SocketTest(BufferIoBackend backend)
+{
+    BufferIo * io = BufferIo_Create(4, backend);
+    int fds[2];
+    long total = 0;
+    uint8_t readData[16];
+    Buffer destination = {
+            .data = readData,
+            .size = sizeof(readData),
+    };
+    BUFFER_INLINE(message, 8);
+
+    if (io == NULL) {
+        TEST_ASSERT_EQUAL(BUFFER_IO_URING, backend);
+        TEST_IGNORE_MESSAGE("io_uring is not available");
+    }
+    TEST_ASSERT_EQUAL(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+
+    /* the read waits for data of the write queued after it */
+    Buffer_Write(&message, "ping", 4);
+    TEST_ASSERT_TRUE(BufferIo_SubmitRead(io, fds[0], -1, &destination, BufferIo_CountCallback, &total));
+    TEST_ASSERT_EQUAL(1, BufferIo_Flush(io));
+    TEST_ASSERT_TRUE(BufferIo_SubmitWrite(io, fds[1], -1, &message, BufferIo_CountCallback, &total));
+    while (BufferIo_InFlight(io) > 0) {
+        BufferIo_Poll(io, true);
+    }
+    TEST_ASSERT_EQUAL(8, total);
+    TEST_ASSERT_EQUAL(4, destination.written);
+    TEST_ASSERT_EQUAL_CHAR_ARRAY("ping", readData, 4);
+
+    /* both queued in a single batch */
+    total = 0;
+    TEST_ASSERT_TRUE(BufferIo_SubmitRead(io, fds[1], -1, &destination, BufferIo_CountCallback, &total));
+    TEST_ASSERT_TRUE(BufferIo_SubmitWrite(io, fds[0], -1, &message, BufferIo_CountCallback, &total));
+    while (BufferIo_InFlight(io) > 0) {
+        BufferIo_Poll(io, true);
+    }
+    TEST_ASSERT_EQUAL(8, total);
+    TEST_ASSERT_EQUAL_CHAR_ARRAY("pingping", readData, 8);
+
+    BufferIo_Destroy(io);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_BufferIo_Thread(void)
+{
+    BufferIo_Test(BUFFER_IO_THREAD);
+}
+
+void test_BufferIo_Uring(void)
+{
+    BufferIo_Test(BUFFER_IO_URING);
+}
+
+void test_BufferIo_Thread_ReadBeforeWrite(void)
+{
+    BufferIo_SocketTest(BUFFER_IO_THREAD);
+}
+
+void test_BufferIo_Uring_ReadBeforeWrite(void)
+{
+    BufferIo_SocketTest(BUFFER_IO_URING);
+}
+#endif
+
 void setUp(void)
 {
     // set stuff up here
@@ -548,6 +2115,12 @@ int runUnityTests(void)
 {
     UNITY_BEGIN();
     RUN_TEST(test_Buffer_AllocData_FreeData);
+    RUN_TEST(test_Buffer_AllocDataEx);
+    RUN_TEST(test_Buffer_AllocDataEx_HugePages);
+    RUN_TEST(test_Buffer_Inline);
+    RUN_TEST(test_Buffer_HandBuilt);
+    RUN_TEST(test_Buffer_NotOwned);
+    RUN_TEST(test_Buffer_Small_Reserve);
 
     RUN_TEST(test_Buffer_WriteAvailable);
 
@@ -561,13 +2134,18 @@ int runUnityTests(void)
     RUN_TEST(test_Buffer_WriteS16);
     RUN_TEST(test_Buffer_WriteS8);
 
+    RUN_TEST(test_Buffer_WriteVarU64);
+
     RUN_TEST(test_Buffer_WriteStr);
+    RUN_TEST(test_Buffer_WriteStrPrefixed);
 
     RUN_TEST(test_Buffer_Write);
     RUN_TEST(test_Buffer_Clear);
     RUN_TEST(test_Buffer_MoveBy);
 
     RUN_TEST(test_Buffer_ReadAvailable);
+    RUN_TEST(test_ConstBuffer_MarkRewind);
+    RUN_TEST(test_Buffer_Peek);
 
     RUN_TEST(test_Buffer_ReadU64);
     RUN_TEST(test_Buffer_ReadU32);
@@ -579,9 +2157,62 @@ int runUnityTests(void)
     RUN_TEST(test_Buffer_ReadS16);
     RUN_TEST(test_Buffer_ReadS8);
 
+    RUN_TEST(test_Buffer_ReadVarU64);
+    RUN_TEST(test_Buffer_ReadVarU64_Overflow);
+    RUN_TEST(test_Buffer_ReadStrPrefixed);
+
     RUN_TEST(test_Buffer_Read);
 
     RUN_TEST(test_Buffer_Format);
+
+    RUN_TEST(test_BufferPool_AcquireRelease);
+    RUN_TEST(test_BufferPool_Overflow);
+    RUN_TEST(test_BufferPool_LargeSizes);
+#if defined(__unix__) || defined(__APPLE__)
+    RUN_TEST(test_BufferPool_ReleaseFromOtherThread);
+#endif
+
+    RUN_TEST(test_Buffer_WriteHex_ReadHex);
+    RUN_TEST(test_Buffer_ReadHex_Invalid);
+    RUN_TEST(test_Buffer_WriteBase64_ReadBase64);
+    RUN_TEST(test_Buffer_ReadBase64_Invalid);
+
+    RUN_TEST(test_BitBuffer_WriteMsbFirst);
+    RUN_TEST(test_BitBuffer_WriteLsbFirst);
+    RUN_TEST(test_BitBuffer_ReadWrite);
+
+    RUN_TEST(test_SharedBuffer_Share);
+    RUN_TEST(test_SharedBuffer_NotOwned);
+
+    RUN_TEST(test_Buffer_WriteArray_ReadArray);
+    RUN_TEST(test_Buffer_ArrayParallel);
+
+#if defined(__unix__) || defined(__APPLE__)
+    RUN_TEST(test_BufferIo_Thread);
+    RUN_TEST(test_BufferIo_Uring);
+    RUN_TEST(test_BufferIo_Thread_ReadBeforeWrite);
+    RUN_TEST(test_BufferIo_Uring_ReadBeforeWrite);
+#endif
+
+    RUN_TEST(test_Buffer_Compress_Decompress);
+    RUN_TEST(test_CompressedWriter_Reader);
+
+    RUN_TEST(test_Buffer_WriteTlv_ReadTlv);
+    RUN_TEST(test_TlvIndex);
+
+    RUN_TEST(test_Buffer_Delta);
+    RUN_TEST(test_Buffer_DeltaOfDelta);
+    RUN_TEST(test_Buffer_DeltaPacked);
+
+    RUN_TEST(test_Buffer_WriteColumns_ReadColumns);
+
+    RUN_TEST(test_BufferCpu_Levels);
+
+    RUN_TEST(test_Buffer_WriteDictStr_ReadDictStr);
+
+    RUN_TEST(test_BufferSizer);
+
+    RUN_TEST(test_Buffer_WriteNonTemporal_ReadNonTemporal);
     return UNITY_END();
 }
 
@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: MIT
+// Author: ELEKON, s.r.o., Vyškov
+
+#include "unity.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "buffer_coro.hpp"
+
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+
+using buffer::BufferReader;
+using buffer::EndOfInput;
+using buffer::ReadTask;
+
+struct Record {
+    uint8_t u8;
+    uint16_t u16;
+    uint32_t u32;
+    uint64_t u64;
+    int32_t s32;
+    uint64_t var;
+    std::string text;
+};
+
+static ReadTask<Record> ReadRecord(BufferReader & reader)
+{
+    Record record;
+
+    record.u8 = co_await reader.u8();
+    record.u16 = co_await reader.u16();
+    record.u32 = co_await reader.u32();
+    record.u64 = co_await reader.u64();
+    record.s32 = co_await reader.s32();
+    record.var = co_await reader.varU64();
+    ConstBuffer text = co_await reader.bytes(co_await reader.varU64());
+    record.text.assign(text.sdata + text.read, text.size - text.read);
+    co_return record;
+}
+
+static void WriteRecord(Buffer * out, uint8_t index)
+{
+    std::string text = "record " + std::to_string(index);
+
+    Buffer_WriteU8(out, index);
+    Buffer_WriteU16(out, 0x1122);
+    Buffer_WriteU32(out, 0x33445566UL);
+    Buffer_WriteU64(out, 0x778899aabbccddeeULL + index);
+    Buffer_WriteS32(out, -1 - index);
+    Buffer_WriteVarU64(out, (uint64_t)index << 40);
+    Buffer_WriteVarU64(out, text.size());
+    Buffer_Write(out, text.data(), text.size());
+}
+
+static ReadTask<> ReadRecords(BufferReader & reader, std::vector<Record> & records, bool & ended)
+{
+    try {
+        for (;;) {
+            records.push_back(co_await ReadRecord(reader));
+        }
+    } catch (const EndOfInput &) {
+        ended = true;
+    }
+}
+
+void test_BufferReader_Fragmented(void)
+{
+    BUFFER_INLINE(out, 1024);
+    std::vector<Record> records;
+    bool ended = false;
+
+    for (uint8_t i = 0; i < 10; i++) {
+        WriteRecord(&out, i);
+    }
+
+    /* small capacity makes the reader discard consumed data and grow */
+    BufferReader reader(4);
+    ReadTask<> task = ReadRecords(reader, records, ended);
+
+    for (size_t fed = 0, step = 1; fed < out.written; fed += step, step = step % 5 + 1) {
+        if (step > out.written - fed) {
+            step = out.written - fed;
+        }
+        TEST_ASSERT_TRUE(reader.feed(out.data + fed, step));
+        TEST_ASSERT_FALSE(task.done());
+    }
+
+    TEST_ASSERT_EQUAL(10, records.size());
+    for (uint8_t i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL_UINT8(i, records[i].u8);
+        TEST_ASSERT_EQUAL_UINT16(0x1122, records[i].u16);
+        TEST_ASSERT_EQUAL_UINT32(0x33445566UL, records[i].u32);
+        TEST_ASSERT_EQUAL_UINT64(0x778899aabbccddeeULL + i, records[i].u64);
+        TEST_ASSERT_EQUAL_INT32(-1 - i, records[i].s32);
+        TEST_ASSERT_EQUAL_UINT64((uint64_t)i << 40, records[i].var);
+        TEST_ASSERT_EQUAL_STRING(("record " + std::to_string(i)).c_str(), records[i].text.c_str());
+    }
+    TEST_ASSERT_EQUAL(0, reader.available());
+    TEST_ASSERT_FALSE(ended);
+
+    reader.close();
+    TEST_ASSERT_TRUE(task.done());
+    TEST_ASSERT_TRUE(ended);
+}
+
+void test_BufferReader_CloseThrows(void)
+{
+    BUFFER_INLINE(out, 64);
+    BufferReader reader(16);
+    bool thrown = false;
+
+    WriteRecord(&out, 1);
+    ReadTask<Record> task = ReadRecord(reader);
+
+    /* the record misses its last byte */
+    TEST_ASSERT_TRUE(reader.feed(out.data, out.written - 1));
+    TEST_ASSERT_FALSE(task.done());
+    reader.close();
+    TEST_ASSERT_TRUE(task.done());
+
+    try {
+        task.result();
+    } catch (const EndOfInput &) {
+        thrown = true;
+    }
+    TEST_ASSERT_TRUE(thrown);
+    TEST_ASSERT_GREATER_THAN(0, reader.available());
+
+    /* later reads which miss data throw right away */
+    ReadTask<Record> next = ReadRecord(reader);
+    TEST_ASSERT_TRUE(next.done());
+    thrown = false;
+    try {
+        next.result();
+    } catch (const EndOfInput &) {
+        thrown = true;
+    }
+    TEST_ASSERT_TRUE(thrown);
+}
+
+void test_BufferReader_InvalidVarint(void)
+{
+    const uint8_t data[] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02};
+    BufferReader reader(16);
+    ReadTask<uint64_t> task = reader.varU64();
+    bool thrown = false;
+
+    TEST_ASSERT_TRUE(reader.feed(data, 5));
+    TEST_ASSERT_FALSE(task.done());
+    TEST_ASSERT_TRUE(reader.feed(data + 5, sizeof(data) - 5));
+    TEST_ASSERT_TRUE(task.done());
+
+    try {
+        task.result();
+    } catch (const EndOfInput &) {
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    TEST_ASSERT_TRUE(thrown);
+}
+
+#endif
+
+void setUp(void)
+{
+    // set stuff up here
+}
+
+void tearDown(void)
+{
+    // clean stuff up here
+}
+
+int runUnityTests(void)
+{
+    UNITY_BEGIN();
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+    RUN_TEST(test_BufferReader_Fragmented);
+    RUN_TEST(test_BufferReader_CloseThrows);
+    RUN_TEST(test_BufferReader_InvalidVarint);
+#endif
+    return UNITY_END();
+}
+
+int main(void)
+{
+    return runUnityTests();
+}